@@ -0,0 +1,94 @@
+import 'dart:ffi';
+import 'dart:math' as math;
+import 'vtz_tile.dart';
+import 'vtz_geometry_store.dart';
+import 'vtz_bindings.dart';
+import '../vtzero_dart_bindings_generated.dart' as ffi_bindings;
+
+/// Decodes a tile into a [VtzGeometryStore] a slice at a time
+///
+/// The layer and feature cursor is kept natively between [step] calls, so a
+/// large tile can be decoded across several frames with a bounded cost per
+/// frame and the first layers displayed before the rest is decoded. The
+/// session reads the tile's buffer, so [step] throws once the tile is disposed.
+class VtzDecodeSession {
+  final Pointer<ffi_bindings.VtzDecodeSessionHandle> _handle;
+  final VtzTile _tile;
+  bool _disposed = false;
+
+  /// Native step limits are uint32
+  static const int _maxUint32 = 0xFFFFFFFF;
+
+  VtzDecodeSession._(this._handle, this._tile);
+
+  factory VtzDecodeSession(VtzTile tile) {
+    if (tile.isDisposed) {
+      throw StateError('VtzTile has been disposed');
+    }
+    final handle = bindings.vtz_decode_session_create(tile.handle);
+    checkException();
+    if (handle == nullptr) {
+      throw Exception('Failed to create decode session');
+    }
+    return VtzDecodeSession._(handle, tile);
+  }
+
+  /// Decode until [budget] has passed or [maxFeatures] features were decoded,
+  /// whichever comes first, and at least one feature
+  ///
+  /// Without limits the rest of the tile is decoded. Returns the number of
+  /// features added to [store]; throws for a malformed layer, which also ends
+  /// the session.
+  int step({Duration? budget, int? maxFeatures}) {
+    _checkDisposed();
+    if (_tile.isDisposed) {
+      throw StateError('VtzTile of the VtzDecodeSession has been disposed');
+    }
+    // 0 means no limit natively, so shorter budgets still decode one feature
+    final budgetUs = budget == null
+        ? 0
+        : math.min(math.max(budget.inMicroseconds, 1), _maxUint32);
+    final featureLimit = maxFeatures == null
+        ? 0
+        : math.min(math.max(maxFeatures, 1), _maxUint32);
+    final decoded = bindings.vtz_decode_session_step(
+      _handle,
+      budgetUs,
+      featureLimit,
+    );
+    checkException(); // Check for layer format errors
+    return decoded;
+  }
+
+  bool get isDone {
+    _checkDisposed();
+    return bindings.vtz_decode_session_done(_handle);
+  }
+
+  /// View of everything decoded so far
+  ///
+  /// Features are appended in tile order; take a new view after [step] to see
+  /// them. The view is owned by the session and throws once it is disposed.
+  VtzGeometryStore get store {
+    _checkDisposed();
+    return VtzGeometryStore.fromHandle(
+      bindings.vtz_decode_session_store(_handle),
+      owned: false,
+      isOwnerDisposed: () => _disposed,
+    );
+  }
+
+  /// Free native resources, including the store
+  void dispose() {
+    if (!_disposed) {
+      bindings.vtz_decode_session_free(_handle);
+      _disposed = true;
+    }
+  }
+
+  void _checkDisposed() {
+    if (_disposed) {
+      throw StateError('VtzDecodeSession has been disposed');
+    }
+  }
+}
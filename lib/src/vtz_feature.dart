@@ -1,8 +1,11 @@
 import 'dart:ffi';
 import 'package:ffi/ffi.dart';
 import 'vtz_geometry_type.dart';
+import 'vtz_label_anchor.dart';
+import 'vtz_projection.dart';
 import 'vtz_bindings.dart';
-import '../vtzero_dart_bindings_generated.dart';
+import '../vtzero_dart_bindings_generated.dart'
+    hide VtzLabelAnchor, VtzProjectedGeometry;
 
 /// Core vtzero feature wrapper - no external dependencies
 class VtzFeature {
@@ -266,6 +269,34 @@ class VtzFeature {
     }
   }
 
+  /// Decode and project the geometry natively into flat arrays
+  ///
+  /// Parts match [decodeGeometry]. Each [VtzProjection] kind runs its own
+  /// specialized native loop, so this avoids both the per-point callbacks of
+  /// [decodeGeometry] and [toGeoJson] and a second projection pass in Dart.
+  VtzProjectedGeometry decodeProjected(VtzProjection projection) {
+    return decodeProjectedGeometry(_handle, projection);
+  }
+
+  /// Compute label anchors natively from the feature geometry
+  ///
+  /// [VtzLabelAnchorKind.polylabel] returns the pole of inaccessibility of each
+  /// polygon to within [precision] tile units. [VtzLabelAnchorKind.centroid]
+  /// returns one area-weighted (polygons), length-weighted (lines) or mean
+  /// (points) centroid. [VtzLabelAnchorKind.line] returns [count] evenly spaced
+  /// anchors with tangent angles along each linestring; a count of 1 gives the
+  /// length-weighted midpoint. Kinds that do not apply to the geometry type
+  /// return an empty list.
+  List<VtzLabelAnchor> labelAnchors(
+    VtzLabelAnchorKind kind, {
+    double precision = 1.0,
+    int count = 1,
+  }) {
+    return takeLabelAnchors(
+      bindings.vtz_feature_label_anchors(_handle, kind.value, precision, count),
+    );
+  }
+
   /// Reset the property iterator to the beginning
   void resetProperty() {
     bindings.vtz_feature_reset_property(_handle);
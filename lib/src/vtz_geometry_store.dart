@@ -0,0 +1,231 @@
+import 'dart:ffi';
+import 'dart:math' as math;
+import 'dart:typed_data';
+import 'package:ffi/ffi.dart';
+import 'vtz_tile.dart';
+import 'vtz_geometry_type.dart';
+import 'vtz_bindings.dart';
+import '../vtzero_dart_bindings_generated.dart' as ffi_bindings;
+
+/// Layer of a [VtzGeometryStore]
+class VtzGeometryStoreLayer {
+  final String name;
+  final int extent;
+
+  /// Store index of the layer's first feature
+  final int firstFeature;
+  final int featureCount;
+
+  const VtzGeometryStoreLayer({
+    required this.name,
+    required this.extent,
+    required this.firstFeature,
+    required this.featureCount,
+  });
+}
+
+/// Compact native copy of all feature geometry of a tile
+///
+/// Coordinates are kept natively as zigzag-delta encoded 16 or 32 bit tile
+/// coordinates with part offsets, a few bytes per vertex instead of a boxed
+/// list per point. Features are addressed by their position in the tile (layer
+/// by layer, in layer order) and decoded or projected on demand. The store does
+/// not reference the tile, which can be disposed once the store is built.
+class VtzGeometryStore {
+  final Pointer<ffi_bindings.VtzGeometryStoreHandle> _handle;
+  final List<VtzGeometryStoreLayer> layers;
+  final bool _owned;
+  final bool Function()? _isOwnerDisposed;
+  bool _disposed = false;
+
+  /// Wrap an existing native store handle
+  ///
+  /// With [owned] false the handle belongs to someone else (a
+  /// `VtzDecodeSession`) and [dispose] does not free it; [isOwnerDisposed]
+  /// then tells when the owner has freed it. [layers] is read once here.
+  VtzGeometryStore.fromHandle(
+    this._handle, {
+    bool owned = true,
+    bool Function()? isOwnerDisposed,
+  })  : layers = _readLayers(_handle),
+        _owned = owned,
+        _isOwnerDisposed = isOwnerDisposed;
+
+  /// Decode the geometry of every feature of [tile] into a new store
+  ///
+  /// Features with invalid geometry are stored without parts. With [threads]
+  /// other than 1 the features are encoded by that many native worker threads
+  /// (0 uses one per core), which pays off for multi-megabyte tiles; the
+  /// result is identical to a single threaded build.
+  static VtzGeometryStore fromTile(VtzTile tile, {int threads = 1}) {
+    final handle = threads == 1
+        ? bindings.vtz_geometry_store_create(tile.handle)
+        : bindings.vtz_geometry_store_create_parallel(tile.handle, threads);
+    checkException(); // Check for layer format errors
+
+    if (handle == nullptr) {
+      throw Exception('Failed to create geometry store');
+    }
+
+    return VtzGeometryStore.fromHandle(handle);
+  }
+
+  static List<VtzGeometryStoreLayer> _readLayers(
+    Pointer<ffi_bindings.VtzGeometryStoreHandle> handle,
+  ) {
+    return List<VtzGeometryStoreLayer>.generate(
+      bindings.vtz_geometry_store_layer_count(handle),
+      (i) {
+        final layer = bindings.vtz_geometry_store_layer(handle, i);
+        return VtzGeometryStoreLayer(
+          name: layer.name.cast<Utf8>().toDartString(),
+          extent: layer.extent,
+          firstFeature: layer.first_feature,
+          featureCount: layer.feature_count,
+        );
+      },
+    );
+  }
+
+  int get featureCount {
+    _checkDisposed();
+    return bindings.vtz_geometry_store_feature_count(_handle);
+  }
+
+  /// Native memory held by the store in bytes
+  int get byteSize {
+    _checkDisposed();
+    return bindings.vtz_geometry_store_byte_size(_handle);
+  }
+
+  /// View of the feature at [index]; coordinates stay native until requested
+  VtzStoredGeometry operator [](int index) {
+    _checkDisposed();
+    RangeError.checkValidIndex(index, this, 'index', featureCount);
+    final feature = bindings.vtz_geometry_store_feature(_handle, index);
+    return VtzStoredGeometry._(
+      this,
+      index,
+      geometryType: feature.geometry_type <= 3
+          ? VtzGeometryType.values[feature.geometry_type]
+          : VtzGeometryType.unknown,
+      layerIndex: feature.layer_index,
+      partCount: feature.part_count,
+      pointCount: feature.point_count,
+    );
+  }
+
+  /// Free native resources
+  void dispose() {
+    if (!_disposed) {
+      if (_owned) bindings.vtz_geometry_store_free(_handle);
+      _disposed = true;
+    }
+  }
+
+  void _checkDisposed() {
+    if (_disposed) {
+      throw StateError('VtzGeometryStore has been disposed');
+    }
+    if (_isOwnerDisposed?.call() ?? false) {
+      throw StateError(
+        'VtzDecodeSession of the VtzGeometryStore has been disposed',
+      );
+    }
+  }
+}
+
+/// Thin view of one feature's geometry in a [VtzGeometryStore]
+class VtzStoredGeometry {
+  final VtzGeometryStore _store;
+
+  /// Position of the feature in the store
+  final int index;
+  final VtzGeometryType geometryType;
+  final int layerIndex;
+
+  /// Number of parts: 1 for (multi)points, one per linestring or polygon ring
+  final int partCount;
+  final int pointCount;
+
+  VtzStoredGeometry._(
+    this._store,
+    this.index, {
+    required this.geometryType,
+    required this.layerIndex,
+    required this.partCount,
+    required this.pointCount,
+  });
+
+  /// [partCount] + 1 point offsets; part i spans points [offsets[i], offsets[i + 1])
+  Uint32List get partOffsets {
+    _store._checkDisposed();
+    final capacity = partCount + 1;
+    final out = malloc<Uint32>(capacity);
+    final count = bindings.vtz_geometry_store_part_offsets(
+      _store._handle,
+      index,
+      out,
+      capacity,
+    );
+    final result = out.asTypedList(math.min(count, capacity)).sublist(0);
+    malloc.free(out);
+    return result;
+  }
+
+  /// x, y pairs in tile coordinates of parts [partBegin, partEnd)
+  Int32List coordinates({int partBegin = 0, int? partEnd}) {
+    _store._checkDisposed();
+    final out = malloc<Int32>(math.max(1, pointCount * 2));
+    final count = bindings.vtz_geometry_store_decode(
+      _store._handle,
+      index,
+      partBegin,
+      partEnd ?? partCount,
+      out,
+      pointCount,
+    );
+    final result = out.asTypedList(math.min(count, pointCount) * 2).sublist(0);
+    malloc.free(out);
+    return result;
+  }
+
+  /// lon, lat pairs (Web Mercator) of parts [partBegin, partEnd) for tile
+  /// [tileZ]/[tileX]/[tileY], projected like `VtzFeature.toGeoJson`
+  Float64List lonLat({
+    required int tileZ,
+    required int tileX,
+    required int tileY,
+    int partBegin = 0,
+    int? partEnd,
+  }) {
+    _store._checkDisposed();
+    final out = malloc<Double>(math.max(1, pointCount * 2));
+    final count = bindings.vtz_geometry_store_project(
+      _store._handle,
+      index,
+      partBegin,
+      partEnd ?? partCount,
+      tileZ,
+      tileX,
+      tileY,
+      out,
+      pointCount,
+    );
+    final result = out.asTypedList(math.min(count, pointCount) * 2).sublist(0);
+    malloc.free(out);
+    return result;
+  }
+
+  /// Nested lists in the shape of `VtzFeature.decodeGeometry`
+  List<List<List<double>>> toList() {
+    final offsets = partOffsets;
+    final xy = coordinates();
+    return List.generate(partCount, (part) {
+      return [
+        for (var i = offsets[part]; i < offsets[part + 1]; i++)
+          [xy[i * 2].toDouble(), xy[i * 2 + 1].toDouble()],
+      ];
+    });
+  }
+}
@@ -0,0 +1,64 @@
+import 'dart:ffi';
+import 'vtz_bindings.dart';
+import '../vtzero_dart_bindings_generated.dart' as ffi_bindings;
+
+export '../vtzero_dart_bindings_generated.dart' show VtzLabelAnchorKind;
+
+/// Label placement anchor in tile coordinates
+class VtzLabelAnchor {
+  final double x;
+  final double y;
+
+  /// Line tangent in radians (atan2 in tile coordinates), 0 for polygons and points
+  final double angle;
+
+  /// Polylabel: distance to the polygon outline.
+  /// Centroid: polygon area, line length or point count.
+  /// Line: length of the linestring the anchor lies on.
+  final double weight;
+
+  /// Position of the feature in its layer, 0 for single feature anchors
+  final int featureIndex;
+
+  /// Polygon or linestring index within the feature
+  final int partIndex;
+
+  const VtzLabelAnchor({
+    required this.x,
+    required this.y,
+    required this.angle,
+    required this.weight,
+    required this.featureIndex,
+    required this.partIndex,
+  });
+
+  @override
+  String toString() =>
+      'VtzLabelAnchor($x, $y, angle: $angle, weight: $weight, '
+      'feature: $featureIndex, part: $partIndex)';
+}
+
+/// Copy anchors out of a native result and free it
+List<VtzLabelAnchor> takeLabelAnchors(
+  Pointer<ffi_bindings.VtzLabelAnchorsHandle> handle,
+) {
+  checkException(); // Check for geometry errors
+  if (handle == nullptr) return const [];
+
+  final count = bindings.vtz_label_anchors_count(handle);
+  final data = bindings.vtz_label_anchors_data(handle);
+  final anchors = List<VtzLabelAnchor>.generate(count, (i) {
+    final anchor = data[i];
+    return VtzLabelAnchor(
+      x: anchor.x,
+      y: anchor.y,
+      angle: anchor.angle,
+      weight: anchor.weight,
+      featureIndex: anchor.feature_index,
+      partIndex: anchor.part_index,
+    );
+  });
+
+  bindings.vtz_label_anchors_free(handle);
+  return anchors;
+}
@@ -1,8 +1,11 @@
 import 'dart:ffi';
+import 'dart:typed_data';
+import 'package:ffi/ffi.dart';
 import 'vtz_feature.dart';
 import 'vtz_property_value.dart';
+import 'vtz_label_anchor.dart';
 import 'vtz_bindings.dart';
-import '../vtzero_dart_bindings_generated.dart';
+import '../vtzero_dart_bindings_generated.dart' hide VtzLabelAnchor;
 
 /// Core vtzero layer wrapper - no external dependencies
 class VtzLayer {
@@ -33,6 +36,77 @@ class VtzLayer {
     return features;
   }
 
+  /// Build an id -> feature index for this layer
+  ///
+  /// The index is built in one pass, held by the tile and shared by every
+  /// layer object of that tile, so [getFeatureById] and [getFeaturesByIds]
+  /// become hash lookups. Returns the number of indexed ids.
+  int buildFeatureIndex() {
+    final count = bindings.vtz_layer_build_feature_index(_handle);
+    checkException(); // Check for exceptions while scanning features
+    return count;
+  }
+
+  /// Get the feature with the given id, or null if there is none
+  ///
+  /// Scans the layer unless [buildFeatureIndex] was called. If several
+  /// features share the id the first one is returned.
+  VtzFeature? getFeatureById(int id) {
+    final featureHandle = bindings.vtz_layer_get_feature_by_id(_handle, id);
+    checkException(); // Check for exceptions during lookup
+    if (featureHandle == nullptr) return null;
+    return VtzFeature(featureHandle);
+  }
+
+  /// Get the features for a list of ids, null where no feature has the id
+  ///
+  /// Without an index the layer is scanned once for all ids.
+  List<VtzFeature?> getFeaturesByIds(List<int> ids) {
+    if (ids.isEmpty) return [];
+
+    final idsPtr = malloc<Uint64>(ids.length);
+    final outPtr = malloc<Pointer<VtzFeatureHandle>>(ids.length);
+    for (var i = 0; i < ids.length; i++) {
+      idsPtr[i] = ids[i];
+    }
+
+    bindings.vtz_layer_get_features_by_ids(_handle, idsPtr, ids.length, outPtr);
+
+    final features = List<VtzFeature?>.generate(ids.length, (i) {
+      final featureHandle = outPtr[i];
+      return featureHandle == nullptr ? null : VtzFeature(featureHandle);
+    });
+
+    malloc.free(idsPtr);
+    malloc.free(outPtr);
+    checkException(); // Check for exceptions during lookup
+
+    return features;
+  }
+
+  /// 64-bit XXH64 hash of the raw layer message
+  ///
+  /// Stable across runs and platforms, so a refreshed tile whose layer hashes
+  /// match the previous ones can reuse everything derived from those layers.
+  int get contentHash => bindings.vtz_layer_hash(_handle);
+
+  /// XXH64 hashes of every feature message, in layer order
+  ///
+  /// Features refer to the layer's key and value tables by index, so equal
+  /// hashes mean equal geometry and ids but only equal properties if the
+  /// tables are equal too. Does not affect [getFeatures].
+  Uint64List featureHashes() {
+    final count = bindings.vtz_layer_feature_hashes(_handle, nullptr, 0);
+    checkException(); // Check for exceptions while scanning features
+    if (count == 0) return Uint64List(0);
+
+    final out = malloc<Uint64>(count);
+    bindings.vtz_layer_feature_hashes(_handle, out, count);
+    final hashes = out.asTypedList(count).sublist(0);
+    malloc.free(out);
+    return hashes;
+  }
+
   /// Get feature count without allocating feature objects
   int get featureCount {
     // Count features without creating Dart objects
@@ -47,6 +121,22 @@ class VtzLayer {
     return count;
   }
 
+  /// Compute label anchors for all features in one native call
+  ///
+  /// See [VtzFeature.labelAnchors] for the anchor kinds. Each anchor's
+  /// [VtzLabelAnchor.featureIndex] is the feature's position in the layer.
+  /// Features with invalid geometry are skipped. Does not affect
+  /// [getFeatures].
+  List<VtzLabelAnchor> labelAnchors(
+    VtzLabelAnchorKind kind, {
+    double precision = 1.0,
+    int count = 1,
+  }) {
+    return takeLabelAnchors(
+      bindings.vtz_layer_label_anchors(_handle, kind.value, precision, count),
+    );
+  }
+
   /// Get the size of the value table
   int get valueTableSize {
     return bindings.vtz_layer_value_table_size(_handle);
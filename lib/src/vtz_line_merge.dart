@@ -0,0 +1,134 @@
+import 'dart:ffi';
+import 'dart:math' as math;
+import 'dart:typed_data';
+import 'package:ffi/ffi.dart';
+import 'vtz_tile.dart';
+import 'vtz_bindings.dart';
+import '../vtzero_dart_bindings_generated.dart' as ffi_bindings;
+
+export '../vtzero_dart_bindings_generated.dart' show VtzMergeKeyKind;
+
+/// A tile and its position, input to [VtzLineMerger.merge]
+class VtzMergeTile {
+  final VtzTile tile;
+  final int z;
+  final int x;
+  final int y;
+
+  const VtzMergeTile(this.tile, {required this.z, required this.x, required this.y});
+}
+
+/// A line joined from pieces in one or more tiles
+class VtzMergedLine {
+  /// Property value or feature id the line was grouped by, empty for
+  /// [VtzMergeKeyKind.layer] and for lines without the key
+  final String key;
+
+  /// Number of clipped tile pieces joined into this line
+  final int pieceCount;
+
+  /// x, y pairs in world coordinates (origin top-left, y down)
+  final Float64List coordinates;
+
+  const VtzMergedLine({
+    required this.key,
+    required this.pieceCount,
+    required this.coordinates,
+  });
+
+  int get pointCount => coordinates.length ~/ 2;
+}
+
+/// Result of [VtzLineMerger.merge]
+class VtzMergedLines {
+  final List<VtzMergedLine> lines;
+
+  /// Size of the world in world units (largest layer extent * 2^max zoom)
+  final double worldSize;
+
+  const VtzMergedLines({required this.lines, required this.worldSize});
+
+  /// Project a world coordinate to lon/lat (Web Mercator)
+  ({double lon, double lat}) toLonLat(double x, double y) {
+    final y2 = 180.0 - y * 360.0 / worldSize;
+    return (
+      lon: x * 360.0 / worldSize - 180.0,
+      lat: 360.0 / math.pi * math.atan(math.exp(y2 * math.pi / 180.0)) - 90.0,
+    );
+  }
+}
+
+/// Joins linestrings that were cut at tile boundaries
+class VtzLineMerger {
+  /// Merge the linestrings of [layer] across [tiles]
+  ///
+  /// Lines are clipped to their tile and converted to a shared world space.
+  /// Pieces with the same key whose endpoints on tile edges are within
+  /// [tolerance] world units are joined, reversing pieces where needed. With
+  /// [VtzMergeKeyKind.property] lines are grouped by the value of [property];
+  /// lines without the property or id are returned unmerged. Features with
+  /// invalid geometry are skipped.
+  static VtzMergedLines merge(
+    List<VtzMergeTile> tiles, {
+    required String layer,
+    VtzMergeKeyKind keyKind = VtzMergeKeyKind.layer,
+    String? property,
+    double tolerance = 1.0,
+  }) {
+    if (keyKind == VtzMergeKeyKind.property && property == null) {
+      throw ArgumentError('property is required for VtzMergeKeyKind.property');
+    }
+
+    final tilesPtr = malloc<ffi_bindings.VtzMergeTile>(
+      tiles.isEmpty ? 1 : tiles.length,
+    );
+    for (var i = 0; i < tiles.length; i++) {
+      tilesPtr[i]
+        ..tile = tiles[i].tile.handle
+        ..z = tiles[i].z
+        ..x = tiles[i].x
+        ..y = tiles[i].y;
+    }
+    final layerPtr = layer.toNativeUtf8();
+    final propertyPtr = property?.toNativeUtf8() ?? nullptr;
+
+    final handle = bindings.vtz_merge_lines(
+      tilesPtr,
+      tiles.length,
+      layerPtr.cast(),
+      keyKind.value,
+      propertyPtr.cast(),
+      tolerance,
+    );
+
+    malloc.free(tilesPtr);
+    malloc.free(layerPtr);
+    if (propertyPtr != nullptr) malloc.free(propertyPtr);
+    checkException(); // Check for geometry errors
+
+    if (handle == nullptr) {
+      throw Exception('Failed to merge lines');
+    }
+
+    final count = bindings.vtz_merged_lines_count(handle);
+    final coordinates = bindings.vtz_merged_lines_coordinates(handle);
+    final offsets = bindings.vtz_merged_lines_offsets(handle);
+
+    final lines = List<VtzMergedLine>.generate(count, (i) {
+      final start = offsets[i] * 2;
+      final end = offsets[i + 1] * 2;
+      return VtzMergedLine(
+        key: bindings.vtz_merged_lines_key(handle, i).cast<Utf8>().toDartString(),
+        pieceCount: bindings.vtz_merged_lines_piece_count(handle, i),
+        coordinates: coordinates.asTypedList(end).sublist(start),
+      );
+    });
+
+    final result = VtzMergedLines(
+      lines: lines,
+      worldSize: bindings.vtz_merged_lines_world_size(handle),
+    );
+    bindings.vtz_merged_lines_free(handle);
+    return result;
+  }
+}
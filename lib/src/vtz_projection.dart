@@ -0,0 +1,161 @@
+import 'dart:ffi';
+import 'dart:typed_data';
+import 'package:ffi/ffi.dart';
+import 'vtz_bindings.dart';
+import '../vtzero_dart_bindings_generated.dart' as ffi_bindings;
+
+export '../vtzero_dart_bindings_generated.dart' show VtzProjectionKind;
+
+/// Deepest zoom whose tile columns and rows fit the native int32 tile x, y
+const int _maxTileZ = 31;
+
+/// Output coordinate system for `VtzFeature.decodeProjected`
+class VtzProjection {
+  final VtzProjectionKind kind;
+  final int extent;
+  final int tileZ;
+  final int tileX;
+  final int tileY;
+
+  /// {a, b, c, d, e, f}: x' = a*x + b*y + c, y' = d*x + e*y + f
+  final List<double> affine;
+
+  const VtzProjection._(
+    this.kind, {
+    this.extent = 0,
+    this.tileZ = 0,
+    this.tileX = 0,
+    this.tileY = 0,
+    this.affine = const [1, 0, 0, 0, 1, 0],
+  });
+
+  /// Tile coordinates as doubles
+  const VtzProjection.tile() : this._(VtzProjectionKind.tile);
+
+  /// EPSG:3857 meters for tile [tileZ]/[tileX]/[tileY] of a layer with [extent]
+  const VtzProjection.webMercatorMeters({
+    required int extent,
+    required int tileZ,
+    required int tileX,
+    required int tileY,
+  }) : this._(
+         VtzProjectionKind.webMercatorMeters,
+         extent: extent,
+         tileZ: tileZ,
+         tileX: tileX,
+         tileY: tileY,
+       );
+
+  /// Longitude, latitude, projected like `VtzFeature.toGeoJson`
+  const VtzProjection.wgs84({
+    required int extent,
+    required int tileZ,
+    required int tileX,
+    required int tileY,
+  }) : this._(
+         VtzProjectionKind.wgs84,
+         extent: extent,
+         tileZ: tileZ,
+         tileX: tileX,
+         tileY: tileY,
+       );
+
+  /// Affine transform of tile coordinates, e.g. to screen pixels:
+  /// x' = [a] * x + [b] * y + [c], y' = [d] * x + [e] * y + [f]
+  VtzProjection.screen({
+    double a = 1,
+    double b = 0,
+    double c = 0,
+    double d = 0,
+    double e = 1,
+    double f = 0,
+  }) : this._(VtzProjectionKind.screen, affine: [a, b, c, d, e, f]);
+}
+
+/// Geometry decoded by `VtzFeature.decodeProjected`
+class VtzProjectedGeometry {
+  /// x, y pairs in the projection's coordinate system
+  final Float64List coordinates;
+
+  /// Part count + 1 offsets; part i spans points [offsets[i], offsets[i + 1])
+  final Uint32List partOffsets;
+
+  const VtzProjectedGeometry(this.coordinates, this.partOffsets);
+
+  int get partCount => partOffsets.length - 1;
+  int get pointCount => coordinates.length ~/ 2;
+}
+
+/// Decode a feature's geometry natively into [projection]
+///
+/// Buffers are sized for typical features; larger geometries report their size
+/// and are decoded a second time into exactly sized buffers. Throws an
+/// [ArgumentError] for a `tileZ` outside 0 to 31.
+VtzProjectedGeometry decodeProjectedGeometry(
+  Pointer<ffi_bindings.VtzFeatureHandle> feature,
+  VtzProjection projection,
+) {
+  RangeError.checkValueInInterval(projection.tileZ, 0, _maxTileZ, 'tileZ');
+
+  final params = malloc<ffi_bindings.VtzProjectionParams>();
+  params.ref
+    ..extent = projection.extent
+    ..tile_z = projection.tileZ
+    ..tile_x = projection.tileX
+    ..tile_y = projection.tileY;
+  for (var i = 0; i < 6; i++) {
+    params.ref.affine[i] = projection.affine[i];
+  }
+  final out = malloc<ffi_bindings.VtzProjectedGeometry>();
+
+  var pointCapacity = 256;
+  var partCapacity = 16;
+  try {
+    while (true) {
+      final coordinates = malloc<Double>(pointCapacity * 2);
+      final partOffsets = malloc<Uint32>(partCapacity);
+      out.ref
+        ..coordinates = coordinates
+        ..point_capacity = pointCapacity
+        ..part_offsets = partOffsets
+        ..part_capacity = partCapacity;
+
+      final result = bindings.vtz_feature_decode_projected(
+        feature,
+        projection.kind.value,
+        params,
+        out,
+      );
+      final pointCount = out.ref.point_count;
+      final partCount = out.ref.part_count;
+
+      if (result != 0 ||
+          pointCount > pointCapacity ||
+          partCount > partCapacity) {
+        malloc.free(coordinates);
+        malloc.free(partOffsets);
+        checkException(); // Check for geometry errors
+        if (result != 0) {
+          throw Exception('Error decoding geometry');
+        }
+        pointCapacity = pointCount;
+        partCapacity = partCount;
+        continue;
+      }
+
+      final offsets = Uint32List(partCount + 1);
+      offsets.setRange(0, partCount, partOffsets.asTypedList(partCount));
+      offsets[partCount] = pointCount;
+      final geometry = VtzProjectedGeometry(
+        coordinates.asTypedList(pointCount * 2).sublist(0),
+        offsets,
+      );
+      malloc.free(coordinates);
+      malloc.free(partOffsets);
+      return geometry;
+    }
+  } finally {
+    malloc.free(params);
+    malloc.free(out);
+  }
+}
@@ -0,0 +1,110 @@
+import 'dart:ffi';
+import 'package:ffi/ffi.dart';
+import 'vtz_bindings.dart';
+import '../vtzero_dart_bindings_generated.dart';
+
+export '../vtzero_dart_bindings_generated.dart'
+    show VtzStatsFunction, VtzStatsLatency;
+
+/// Log2-bucketed latency histogram for one native code path
+class VtzLatencyHistogram {
+  /// Number of calls in bucket i, covering [2^i, 2^(i+1)) nanoseconds
+  final List<int> buckets;
+  final int totalNanoseconds;
+
+  const VtzLatencyHistogram({
+    required this.buckets,
+    required this.totalNanoseconds,
+  });
+
+  int get count => buckets.fold(0, (sum, n) => sum + n);
+
+  double get meanNanoseconds => count == 0 ? 0 : totalNanoseconds / count;
+
+  /// Upper bound in nanoseconds of the bucket containing the [p] quantile
+  int percentileNanoseconds(double p) {
+    final total = count;
+    if (total == 0) return 0;
+    final target = (total * p).ceil();
+    var seen = 0;
+    for (var i = 0; i < buckets.length; i++) {
+      seen += buckets[i];
+      if (seen >= target) return 1 << (i + 1);
+    }
+    return 1 << buckets.length;
+  }
+}
+
+/// Snapshot of the native instrumentation counters
+///
+/// Counters are only collected when the native library is built with
+/// `-DVTZERO_DART_ENABLE_STATS=ON`, otherwise [enabled] is false and all
+/// values are zero.
+class VtzStats {
+  final bool enabled;
+  final Map<VtzStatsFunction, int> calls;
+  final Map<VtzStatsLatency, VtzLatencyHistogram> latency;
+  final int bytesProcessed;
+  final int verticesEmitted;
+  final int liveTiles;
+  final int liveLayers;
+  final int liveFeatures;
+  final int livePropertyValues;
+
+  const VtzStats._({
+    required this.enabled,
+    required this.calls,
+    required this.latency,
+    required this.bytesProcessed,
+    required this.verticesEmitted,
+    required this.liveTiles,
+    required this.liveLayers,
+    required this.liveFeatures,
+    required this.livePropertyValues,
+  });
+
+  /// Read the current native counters
+  static VtzStats snapshot() {
+    final snapshotPtr = malloc<VtzStatsSnapshot>();
+    bindings.vtz_stats_snapshot(snapshotPtr);
+    final snapshot = snapshotPtr.ref;
+
+    final calls = <VtzStatsFunction, int>{
+      for (final function in VtzStatsFunction.values)
+        function: snapshot.calls[function.value],
+    };
+
+    final latency = <VtzStatsLatency, VtzLatencyHistogram>{
+      for (final kind in VtzStatsLatency.values)
+        kind: VtzLatencyHistogram(
+          buckets: List<int>.generate(
+            VTZ_STATS_LATENCY_BUCKETS,
+            (i) => snapshot.latency_histogram[kind.value][i],
+          ),
+          totalNanoseconds: snapshot.latency_total_ns[kind.value],
+        ),
+    };
+
+    final stats = VtzStats._(
+      enabled: snapshot.enabled,
+      calls: calls,
+      latency: latency,
+      bytesProcessed: snapshot.bytes_processed,
+      verticesEmitted: snapshot.vertices_emitted,
+      liveTiles: snapshot.live_tiles,
+      liveLayers: snapshot.live_layers,
+      liveFeatures: snapshot.live_features,
+      livePropertyValues: snapshot.live_property_values,
+    );
+
+    malloc.free(snapshotPtr);
+    return stats;
+  }
+
+  /// Reset call counters, histograms and totals
+  ///
+  /// Live handle counts are not reset.
+  static void reset() {
+    bindings.vtz_stats_reset();
+  }
+}
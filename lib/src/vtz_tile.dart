@@ -12,6 +12,9 @@ class VtzTile {
 
   VtzTile._(this._handle);
 
+  /// Wrap an existing native tile handle, taking ownership of it
+  VtzTile.fromHandle(Pointer<VtzTileHandle> handle) : this._(handle);
+
   /// Decode vector tile from raw bytes
   static VtzTile fromBytes(Uint8List bytes) {
     final dataPtr = malloc<Uint8>(bytes.length);
@@ -29,6 +32,28 @@ class VtzTile {
     return VtzTile._(handle);
   }
 
+  /// Decode a gzip or zlib compressed vector tile
+  ///
+  /// The data is inflated natively straight into the tile's buffer, so there
+  /// is no decompressed copy on the Dart heap. Uncompressed bytes are accepted
+  /// as well, which makes this safe to use when the encoding is unknown.
+  static VtzTile fromCompressedBytes(Uint8List bytes) {
+    final dataPtr = malloc<Uint8>(bytes.length);
+    final nativeBytes = dataPtr.asTypedList(bytes.length);
+    nativeBytes.setAll(0, bytes);
+
+    final handle = bindings.vtz_tile_create_compressed(dataPtr, bytes.length);
+
+    malloc.free(dataPtr);
+    checkException(); // Check for inflate errors
+
+    if (handle == nullptr) {
+      throw Exception('Failed to create tile from compressed bytes');
+    }
+
+    return VtzTile._(handle);
+  }
+
   /// Get all layers in this tile
   List<VtzLayer> getLayers() {
     _checkDisposed();
@@ -80,6 +105,15 @@ class VtzTile {
     );
   }
 
+  /// 64-bit XXH64 hash of the (decompressed) tile bytes
+  ///
+  /// Stable across runs and platforms; byte-identical tiles hash equal.
+  /// Returned as a signed 64-bit Dart int.
+  int get contentHash {
+    _checkDisposed();
+    return bindings.vtz_tile_hash(_handle);
+  }
+
   /// Free native resources
   void dispose() {
     if (!_disposed) {
@@ -88,6 +122,8 @@ class VtzTile {
     }
   }
 
+  bool get isDisposed => _disposed;
+
   void _checkDisposed() {
     if (_disposed) {
       throw StateError('VtzTile has been disposed');
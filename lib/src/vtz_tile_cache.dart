@@ -0,0 +1,165 @@
+import 'dart:ffi';
+import 'dart:typed_data';
+import 'package:ffi/ffi.dart';
+import 'vtz_tile.dart';
+import 'vtz_bindings.dart';
+import '../vtzero_dart_bindings_generated.dart';
+
+/// Counters reported by [VtzTileCache.stats]
+class VtzTileCacheStats {
+  final int hits;
+  final int misses;
+  final int evictions;
+  final int entries;
+  final int pinned;
+  final int bytes;
+  final int byteBudget;
+
+  const VtzTileCacheStats({
+    required this.hits,
+    required this.misses,
+    required this.evictions,
+    required this.entries,
+    required this.pinned,
+    required this.bytes,
+    required this.byteBudget,
+  });
+
+  /// Fraction of lookups that were hits
+  double get hitRate {
+    final lookups = hits + misses;
+    return lookups == 0 ? 0 : hits / lookups;
+  }
+
+  @override
+  String toString() =>
+      'VtzTileCacheStats(hits: $hits, misses: $misses, evictions: $evictions, '
+      'entries: $entries, pinned: $pinned, bytes: $bytes/$byteBudget)';
+}
+
+/// Native LRU cache of decoded tiles keyed by (source, z, x, y)
+///
+/// Tiles returned by [get] and [put] share the cached data and pin the entry
+/// until they are disposed, so tiles in use are never evicted. The cache is
+/// thread-safe and may be shared between isolates through its [handle].
+class VtzTileCache {
+  final Pointer<VtzTileCacheHandle> _handle;
+  bool _disposed = false;
+
+  VtzTileCache._(this._handle);
+
+  /// Create a cache holding up to [byteBudget] bytes of tile data
+  ///
+  /// The cache is split into [shardCount] independently locked shards.
+  factory VtzTileCache({
+    int byteBudget = 64 * 1024 * 1024,
+    int shardCount = 8,
+  }) {
+    final handle = bindings.vtz_tile_cache_create(byteBudget, shardCount);
+    if (handle == nullptr) {
+      throw Exception('Failed to create tile cache');
+    }
+    return VtzTileCache._(handle);
+  }
+
+  /// Get a cached tile, or null if it is not in the cache
+  VtzTile? get({
+    required int source,
+    required int z,
+    required int x,
+    required int y,
+  }) {
+    _checkDisposed();
+    final tileHandle = bindings.vtz_tile_cache_get(_handle, source, z, x, y);
+    checkException();
+    if (tileHandle == nullptr) {
+      return null;
+    }
+    return VtzTile.fromHandle(tileHandle);
+  }
+
+  /// Add tile bytes to the cache and return the decoded tile
+  ///
+  /// gzip or zlib compressed bytes are inflated natively before caching.
+  VtzTile put({
+    required int source,
+    required int z,
+    required int x,
+    required int y,
+    required Uint8List bytes,
+  }) {
+    _checkDisposed();
+    final dataPtr = malloc<Uint8>(bytes.length);
+    dataPtr.asTypedList(bytes.length).setAll(0, bytes);
+
+    final tileHandle = bindings.vtz_tile_cache_put(
+      _handle,
+      source,
+      z,
+      x,
+      y,
+      dataPtr,
+      bytes.length,
+    );
+
+    malloc.free(dataPtr);
+    checkException(); // Check for inflate errors
+
+    if (tileHandle == nullptr) {
+      throw Exception('Failed to add tile to cache');
+    }
+
+    return VtzTile.fromHandle(tileHandle);
+  }
+
+  /// Remove a tile from the cache, returns true if it was cached
+  bool remove({
+    required int source,
+    required int z,
+    required int x,
+    required int y,
+  }) {
+    _checkDisposed();
+    return bindings.vtz_tile_cache_remove(_handle, source, z, x, y);
+  }
+
+  /// Remove all tiles from the cache
+  void clear() {
+    _checkDisposed();
+    bindings.vtz_tile_cache_clear(_handle);
+  }
+
+  /// Get hit/miss/eviction counters and memory usage
+  VtzTileCacheStats get stats {
+    _checkDisposed();
+    final stats = bindings.vtz_tile_cache_stats(_handle);
+    checkException();
+    return VtzTileCacheStats(
+      hits: stats.hits,
+      misses: stats.misses,
+      evictions: stats.evictions,
+      entries: stats.entries,
+      pinned: stats.pinned,
+      bytes: stats.bytes,
+      byteBudget: stats.byte_budget,
+    );
+  }
+
+  /// Free native resources
+  ///
+  /// Tiles obtained from the cache stay valid until they are disposed.
+  void dispose() {
+    if (!_disposed) {
+      bindings.vtz_tile_cache_free(_handle);
+      _disposed = true;
+    }
+  }
+
+  void _checkDisposed() {
+    if (_disposed) {
+      throw StateError('VtzTileCache has been disposed');
+    }
+  }
+
+  Pointer<VtzTileCacheHandle> get handle => _handle;
+}
@@ -1,8 +1,15 @@
 // Core vtzero API - no external dependencies
 
 export 'src/vtz_tile.dart';
+export 'src/vtz_tile_cache.dart';
 export 'src/vtz_layer.dart';
 export 'src/vtz_feature.dart';
 export 'src/vtz_geometry_type.dart';
 export 'src/vtz_property_value.dart';
+export 'src/vtz_label_anchor.dart';
+export 'src/vtz_projection.dart';
+export 'src/vtz_line_merge.dart';
+export 'src/vtz_geometry_store.dart';
+export 'src/vtz_decode_session.dart';
 export 'src/vtz_exceptions.dart';
+export 'src/vtz_stats.dart';
@@ -45,6 +45,26 @@ class VtzeroDartBindings {
         ffi.Pointer<VtzTileHandle> Function(ffi.Pointer<ffi.Uint8>, int)
       >();
 
+  /// Create a tile from gzip or zlib compressed data, inflating natively into the tile's buffer.
+  /// Uncompressed data is accepted and copied as with vtz_tile_create.
+  ffi.Pointer<VtzTileHandle> vtz_tile_create_compressed(
+    ffi.Pointer<ffi.Uint8> data,
+    int length,
+  ) {
+    return _vtz_tile_create_compressed(data, length);
+  }
+
+  late final _vtz_tile_create_compressedPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Pointer<VtzTileHandle> Function(ffi.Pointer<ffi.Uint8>, ffi.Size)
+        >
+      >('vtz_tile_create_compressed');
+  late final _vtz_tile_create_compressed = _vtz_tile_create_compressedPtr
+      .asFunction<
+        ffi.Pointer<VtzTileHandle> Function(ffi.Pointer<ffi.Uint8>, int)
+      >();
+
   void vtz_tile_free(ffi.Pointer<VtzTileHandle> handle) {
     return _vtz_tile_free(handle);
   }
@@ -97,6 +117,162 @@ class VtzeroDartBindings {
         )
       >();
 
+  ffi.Pointer<VtzTileCacheHandle> vtz_tile_cache_create(
+    int byte_budget,
+    int shard_count,
+  ) {
+    return _vtz_tile_cache_create(byte_budget, shard_count);
+  }
+
+  late final _vtz_tile_cache_createPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Pointer<VtzTileCacheHandle> Function(ffi.Size, ffi.Uint32)
+        >
+      >('vtz_tile_cache_create');
+  late final _vtz_tile_cache_create = _vtz_tile_cache_createPtr
+      .asFunction<ffi.Pointer<VtzTileCacheHandle> Function(int, int)>();
+
+  void vtz_tile_cache_free(ffi.Pointer<VtzTileCacheHandle> cache) {
+    return _vtz_tile_cache_free(cache);
+  }
+
+  late final _vtz_tile_cache_freePtr =
+      _lookup<
+        ffi.NativeFunction<ffi.Void Function(ffi.Pointer<VtzTileCacheHandle>)>
+      >('vtz_tile_cache_free');
+  late final _vtz_tile_cache_free = _vtz_tile_cache_freePtr
+      .asFunction<void Function(ffi.Pointer<VtzTileCacheHandle>)>();
+
+  /// Returns a new tile handle on a hit, or NULL on a miss
+  ffi.Pointer<VtzTileHandle> vtz_tile_cache_get(
+    ffi.Pointer<VtzTileCacheHandle> cache,
+    int source,
+    int z,
+    int x,
+    int y,
+  ) {
+    return _vtz_tile_cache_get(cache, source, z, x, y);
+  }
+
+  late final _vtz_tile_cache_getPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Pointer<VtzTileHandle> Function(
+            ffi.Pointer<VtzTileCacheHandle>,
+            ffi.Uint64,
+            ffi.Uint32,
+            ffi.Uint32,
+            ffi.Uint32,
+          )
+        >
+      >('vtz_tile_cache_get');
+  late final _vtz_tile_cache_get = _vtz_tile_cache_getPtr
+      .asFunction<
+        ffi.Pointer<VtzTileHandle> Function(
+          ffi.Pointer<VtzTileCacheHandle>,
+          int,
+          int,
+          int,
+          int,
+        )
+      >();
+
+  /// Inserts tile data (inflating gzip/zlib data) and returns a tile handle for it
+  ffi.Pointer<VtzTileHandle> vtz_tile_cache_put(
+    ffi.Pointer<VtzTileCacheHandle> cache,
+    int source,
+    int z,
+    int x,
+    int y,
+    ffi.Pointer<ffi.Uint8> data,
+    int length,
+  ) {
+    return _vtz_tile_cache_put(cache, source, z, x, y, data, length);
+  }
+
+  late final _vtz_tile_cache_putPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Pointer<VtzTileHandle> Function(
+            ffi.Pointer<VtzTileCacheHandle>,
+            ffi.Uint64,
+            ffi.Uint32,
+            ffi.Uint32,
+            ffi.Uint32,
+            ffi.Pointer<ffi.Uint8>,
+            ffi.Size,
+          )
+        >
+      >('vtz_tile_cache_put');
+  late final _vtz_tile_cache_put = _vtz_tile_cache_putPtr
+      .asFunction<
+        ffi.Pointer<VtzTileHandle> Function(
+          ffi.Pointer<VtzTileCacheHandle>,
+          int,
+          int,
+          int,
+          int,
+          ffi.Pointer<ffi.Uint8>,
+          int,
+        )
+      >();
+
+  bool vtz_tile_cache_remove(
+    ffi.Pointer<VtzTileCacheHandle> cache,
+    int source,
+    int z,
+    int x,
+    int y,
+  ) {
+    return _vtz_tile_cache_remove(cache, source, z, x, y);
+  }
+
+  late final _vtz_tile_cache_removePtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Bool Function(
+            ffi.Pointer<VtzTileCacheHandle>,
+            ffi.Uint64,
+            ffi.Uint32,
+            ffi.Uint32,
+            ffi.Uint32,
+          )
+        >
+      >('vtz_tile_cache_remove');
+  late final _vtz_tile_cache_remove = _vtz_tile_cache_removePtr
+      .asFunction<
+        bool Function(ffi.Pointer<VtzTileCacheHandle>, int, int, int, int)
+      >();
+
+  void vtz_tile_cache_clear(ffi.Pointer<VtzTileCacheHandle> cache) {
+    return _vtz_tile_cache_clear(cache);
+  }
+
+  late final _vtz_tile_cache_clearPtr =
+      _lookup<
+        ffi.NativeFunction<ffi.Void Function(ffi.Pointer<VtzTileCacheHandle>)>
+      >('vtz_tile_cache_clear');
+  late final _vtz_tile_cache_clear = _vtz_tile_cache_clearPtr
+      .asFunction<void Function(ffi.Pointer<VtzTileCacheHandle>)>();
+
+  VtzTileCacheStats vtz_tile_cache_stats(
+    ffi.Pointer<VtzTileCacheHandle> cache,
+  ) {
+    return _vtz_tile_cache_stats(cache);
+  }
+
+  late final _vtz_tile_cache_statsPtr =
+      _lookup<
+        ffi.NativeFunction<
+          VtzTileCacheStats Function(ffi.Pointer<VtzTileCacheHandle>)
+        >
+      >('vtz_tile_cache_stats');
+  late final _vtz_tile_cache_stats = _vtz_tile_cache_statsPtr
+      .asFunction<
+        VtzTileCacheStats Function(ffi.Pointer<VtzTileCacheHandle>)
+      >();
+
   /// Layer operations
   void vtz_layer_free(ffi.Pointer<VtzLayerHandle> handle) {
     return _vtz_layer_free(handle);
@@ -165,6 +341,132 @@ class VtzeroDartBindings {
         ffi.Pointer<VtzFeatureHandle> Function(ffi.Pointer<VtzLayerHandle>)
       >();
 
+  /// Feature id index
+  /// Builds (once) an id -> feature index for the layer, held by the tile handle and shared
+  /// by all layer handles of that tile. Returns the number of indexed ids.
+  int vtz_layer_build_feature_index(ffi.Pointer<VtzLayerHandle> layer_handle) {
+    return _vtz_layer_build_feature_index(layer_handle);
+  }
+
+  late final _vtz_layer_build_feature_indexPtr =
+      _lookup<ffi.NativeFunction<ffi.Size Function(ffi.Pointer<VtzLayerHandle>)>>(
+        'vtz_layer_build_feature_index',
+      );
+  late final _vtz_layer_build_feature_index = _vtz_layer_build_feature_indexPtr
+      .asFunction<int Function(ffi.Pointer<VtzLayerHandle>)>();
+
+  /// Looks up a feature by id with a hash probe if the index is built, otherwise by scanning the layer.
+  /// Does not move the layer's feature iterator. Returns NULL if there is no feature with that id.
+  ffi.Pointer<VtzFeatureHandle> vtz_layer_get_feature_by_id(
+    ffi.Pointer<VtzLayerHandle> layer_handle,
+    int id,
+  ) {
+    return _vtz_layer_get_feature_by_id(layer_handle, id);
+  }
+
+  late final _vtz_layer_get_feature_by_idPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Pointer<VtzFeatureHandle> Function(
+            ffi.Pointer<VtzLayerHandle>,
+            ffi.Uint64,
+          )
+        >
+      >('vtz_layer_get_feature_by_id');
+  late final _vtz_layer_get_feature_by_id = _vtz_layer_get_feature_by_idPtr
+      .asFunction<
+        ffi.Pointer<VtzFeatureHandle> Function(ffi.Pointer<VtzLayerHandle>, int)
+      >();
+
+  /// Batch lookup: out_features[i] receives the feature for ids[i], or NULL if not found.
+  /// Without an index the layer is scanned once. Returns the number of features found.
+  int vtz_layer_get_features_by_ids(
+    ffi.Pointer<VtzLayerHandle> layer_handle,
+    ffi.Pointer<ffi.Uint64> ids,
+    int count,
+    ffi.Pointer<ffi.Pointer<VtzFeatureHandle>> out_features,
+  ) {
+    return _vtz_layer_get_features_by_ids(
+      layer_handle,
+      ids,
+      count,
+      out_features,
+    );
+  }
+
+  late final _vtz_layer_get_features_by_idsPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Size Function(
+            ffi.Pointer<VtzLayerHandle>,
+            ffi.Pointer<ffi.Uint64>,
+            ffi.Size,
+            ffi.Pointer<ffi.Pointer<VtzFeatureHandle>>,
+          )
+        >
+      >('vtz_layer_get_features_by_ids');
+  late final _vtz_layer_get_features_by_ids = _vtz_layer_get_features_by_idsPtr
+      .asFunction<
+        int Function(
+          ffi.Pointer<VtzLayerHandle>,
+          ffi.Pointer<ffi.Uint64>,
+          int,
+          ffi.Pointer<ffi.Pointer<VtzFeatureHandle>>,
+        )
+      >();
+
+  /// Content hashing
+  /// 64-bit XXH64 hashes of the raw message bytes, identical across runs and platforms, for cheap
+  /// change detection and as cache keys. Byte-identical messages hash equal; the same content
+  /// encoded differently does not. Feature messages refer to the layer's key and value tables by
+  /// index, so feature hashes only identify properties together with the layer's tables.
+  int vtz_tile_hash(ffi.Pointer<VtzTileHandle> tile_handle) {
+    return _vtz_tile_hash(tile_handle);
+  }
+
+  late final _vtz_tile_hashPtr =
+      _lookup<
+        ffi.NativeFunction<ffi.Uint64 Function(ffi.Pointer<VtzTileHandle>)>
+      >('vtz_tile_hash');
+  late final _vtz_tile_hash = _vtz_tile_hashPtr
+      .asFunction<int Function(ffi.Pointer<VtzTileHandle>)>();
+
+  int vtz_layer_hash(ffi.Pointer<VtzLayerHandle> layer_handle) {
+    return _vtz_layer_hash(layer_handle);
+  }
+
+  late final _vtz_layer_hashPtr =
+      _lookup<
+        ffi.NativeFunction<ffi.Uint64 Function(ffi.Pointer<VtzLayerHandle>)>
+      >('vtz_layer_hash');
+  late final _vtz_layer_hash = _vtz_layer_hashPtr
+      .asFunction<int Function(ffi.Pointer<VtzLayerHandle>)>();
+
+  /// Writes the hashes of the first capacity features in layer order and returns the number of
+  /// features in the layer. Does not move the layer's feature iterator.
+  int vtz_layer_feature_hashes(
+    ffi.Pointer<VtzLayerHandle> layer_handle,
+    ffi.Pointer<ffi.Uint64> out_hashes,
+    int capacity,
+  ) {
+    return _vtz_layer_feature_hashes(layer_handle, out_hashes, capacity);
+  }
+
+  late final _vtz_layer_feature_hashesPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Size Function(
+            ffi.Pointer<VtzLayerHandle>,
+            ffi.Pointer<ffi.Uint64>,
+            ffi.Size,
+          )
+        >
+      >('vtz_layer_feature_hashes');
+  late final _vtz_layer_feature_hashes = _vtz_layer_feature_hashesPtr
+      .asFunction<
+        int Function(ffi.Pointer<VtzLayerHandle>, ffi.Pointer<ffi.Uint64>, int)
+      >();
+
   /// Value table operations
   int vtz_layer_value_table_size(ffi.Pointer<VtzLayerHandle> layer_handle) {
     return _vtz_layer_value_table_size(layer_handle);
@@ -531,78 +833,823 @@ class VtzeroDartBindings {
         )
       >();
 
-  /// Exception handling
-  int vtz_get_last_exception_type() {
-    return _vtz_get_last_exception_type();
+  /// Returns 0 on success, 1 on geometry errors and -1 on other errors
+  int vtz_feature_decode_projected(
+    ffi.Pointer<VtzFeatureHandle> feature_handle,
+    int projection_kind,
+    ffi.Pointer<VtzProjectionParams> params,
+    ffi.Pointer<VtzProjectedGeometry> out,
+  ) {
+    return _vtz_feature_decode_projected(
+      feature_handle,
+      projection_kind,
+      params,
+      out,
+    );
   }
 
-  late final _vtz_get_last_exception_typePtr =
-      _lookup<ffi.NativeFunction<ffi.Int32 Function()>>(
-        'vtz_get_last_exception_type',
-      );
-  late final _vtz_get_last_exception_type = _vtz_get_last_exception_typePtr
-      .asFunction<int Function()>();
+  late final _vtz_feature_decode_projectedPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Int Function(
+            ffi.Pointer<VtzFeatureHandle>,
+            ffi.Int32,
+            ffi.Pointer<VtzProjectionParams>,
+            ffi.Pointer<VtzProjectedGeometry>,
+          )
+        >
+      >('vtz_feature_decode_projected');
+  late final _vtz_feature_decode_projected = _vtz_feature_decode_projectedPtr
+      .asFunction<
+        int Function(
+          ffi.Pointer<VtzFeatureHandle>,
+          int,
+          ffi.Pointer<VtzProjectionParams>,
+          ffi.Pointer<VtzProjectedGeometry>,
+        )
+      >();
 
-  ffi.Pointer<ffi.Char> vtz_get_last_exception_message() {
-    return _vtz_get_last_exception_message();
+  /// precision: polylabel precision in tile units (<= 0 uses 1)
+  /// count: anchors per linestring for VTZ_LABEL_ANCHOR_LINE, 1 gives the length-weighted midpoint
+  /// Features of a geometry type the kind does not apply to produce no anchors.
+  ffi.Pointer<VtzLabelAnchorsHandle> vtz_feature_label_anchors(
+    ffi.Pointer<VtzFeatureHandle> feature_handle,
+    int kind,
+    double precision,
+    int count,
+  ) {
+    return _vtz_feature_label_anchors(feature_handle, kind, precision, count);
   }
 
-  late final _vtz_get_last_exception_messagePtr =
-      _lookup<ffi.NativeFunction<ffi.Pointer<ffi.Char> Function()>>(
-        'vtz_get_last_exception_message',
-      );
-  late final _vtz_get_last_exception_message =
-      _vtz_get_last_exception_messagePtr
-          .asFunction<ffi.Pointer<ffi.Char> Function()>();
+  late final _vtz_feature_label_anchorsPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Pointer<VtzLabelAnchorsHandle> Function(
+            ffi.Pointer<VtzFeatureHandle>,
+            ffi.Int32,
+            ffi.Double,
+            ffi.Uint32,
+          )
+        >
+      >('vtz_feature_label_anchors');
+  late final _vtz_feature_label_anchors = _vtz_feature_label_anchorsPtr
+      .asFunction<
+        ffi.Pointer<VtzLabelAnchorsHandle> Function(
+          ffi.Pointer<VtzFeatureHandle>,
+          int,
+          double,
+          int,
+        )
+      >();
 
-  void vtz_clear_exception() {
-    return _vtz_clear_exception();
+  /// Anchors for all features of a layer in one call; does not move the layer's feature iterator.
+  /// Features with invalid geometry are skipped.
+  ffi.Pointer<VtzLabelAnchorsHandle> vtz_layer_label_anchors(
+    ffi.Pointer<VtzLayerHandle> layer_handle,
+    int kind,
+    double precision,
+    int count,
+  ) {
+    return _vtz_layer_label_anchors(layer_handle, kind, precision, count);
   }
 
-  late final _vtz_clear_exceptionPtr =
-      _lookup<ffi.NativeFunction<ffi.Void Function()>>('vtz_clear_exception');
-  late final _vtz_clear_exception = _vtz_clear_exceptionPtr
-      .asFunction<void Function()>();
-}
+  late final _vtz_layer_label_anchorsPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Pointer<VtzLabelAnchorsHandle> Function(
+            ffi.Pointer<VtzLayerHandle>,
+            ffi.Int32,
+            ffi.Double,
+            ffi.Uint32,
+          )
+        >
+      >('vtz_layer_label_anchors');
+  late final _vtz_layer_label_anchors = _vtz_layer_label_anchorsPtr
+      .asFunction<
+        ffi.Pointer<VtzLabelAnchorsHandle> Function(
+          ffi.Pointer<VtzLayerHandle>,
+          int,
+          double,
+          int,
+        )
+      >();
 
-/// Exception type enum
-enum VtzExceptionType {
-  none(0),
-  format(1),
-  geometry(2),
-  type(3),
-  version(4),
-  outOfRange(5);
+  int vtz_label_anchors_count(
+    ffi.Pointer<VtzLabelAnchorsHandle> anchors_handle,
+  ) {
+    return _vtz_label_anchors_count(anchors_handle);
+  }
 
-  final int value;
-  const VtzExceptionType(this.value);
+  late final _vtz_label_anchors_countPtr =
+      _lookup<
+        ffi.NativeFunction<ffi.Size Function(ffi.Pointer<VtzLabelAnchorsHandle>)>
+      >('vtz_label_anchors_count');
+  late final _vtz_label_anchors_count = _vtz_label_anchors_countPtr
+      .asFunction<int Function(ffi.Pointer<VtzLabelAnchorsHandle>)>();
 
-  static VtzExceptionType fromInt(int value) {
-    switch (value) {
-      case 0:
-        return VtzExceptionType.none;
-      case 1:
-        return VtzExceptionType.format;
-      case 2:
-        return VtzExceptionType.geometry;
-      case 3:
-        return VtzExceptionType.type;
-      case 4:
-        return VtzExceptionType.version;
-      case 5:
-        return VtzExceptionType.outOfRange;
-      default:
-        return VtzExceptionType.none;
-    }
+  ffi.Pointer<VtzLabelAnchor> vtz_label_anchors_data(
+    ffi.Pointer<VtzLabelAnchorsHandle> anchors_handle,
+  ) {
+    return _vtz_label_anchors_data(anchors_handle);
   }
-}
 
-final class VtzTileHandle extends ffi.Opaque {}
+  late final _vtz_label_anchors_dataPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Pointer<VtzLabelAnchor> Function(
+            ffi.Pointer<VtzLabelAnchorsHandle>,
+          )
+        >
+      >('vtz_label_anchors_data');
+  late final _vtz_label_anchors_data = _vtz_label_anchors_dataPtr
+      .asFunction<
+        ffi.Pointer<VtzLabelAnchor> Function(ffi.Pointer<VtzLabelAnchorsHandle>)
+      >();
 
-final class VtzLayerHandle extends ffi.Opaque {}
+  void vtz_label_anchors_free(
+    ffi.Pointer<VtzLabelAnchorsHandle> anchors_handle,
+  ) {
+    return _vtz_label_anchors_free(anchors_handle);
+  }
+
+  late final _vtz_label_anchors_freePtr =
+      _lookup<
+        ffi.NativeFunction<ffi.Void Function(ffi.Pointer<VtzLabelAnchorsHandle>)>
+      >('vtz_label_anchors_free');
+  late final _vtz_label_anchors_free = _vtz_label_anchors_freePtr
+      .asFunction<void Function(ffi.Pointer<VtzLabelAnchorsHandle>)>();
+
+  /// tolerance: maximum endpoint distance in world units. Lines without the key are returned unmerged.
+  ffi.Pointer<VtzMergedLinesHandle> vtz_merge_lines(
+    ffi.Pointer<VtzMergeTile> tiles,
+    int tile_count,
+    ffi.Pointer<ffi.Char> layer_name,
+    int key_kind,
+    ffi.Pointer<ffi.Char> property_key,
+    double tolerance,
+  ) {
+    return _vtz_merge_lines(
+      tiles,
+      tile_count,
+      layer_name,
+      key_kind,
+      property_key,
+      tolerance,
+    );
+  }
+
+  late final _vtz_merge_linesPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Pointer<VtzMergedLinesHandle> Function(
+            ffi.Pointer<VtzMergeTile>,
+            ffi.Size,
+            ffi.Pointer<ffi.Char>,
+            ffi.Int32,
+            ffi.Pointer<ffi.Char>,
+            ffi.Double,
+          )
+        >
+      >('vtz_merge_lines');
+  late final _vtz_merge_lines = _vtz_merge_linesPtr
+      .asFunction<
+        ffi.Pointer<VtzMergedLinesHandle> Function(
+          ffi.Pointer<VtzMergeTile>,
+          int,
+          ffi.Pointer<ffi.Char>,
+          int,
+          ffi.Pointer<ffi.Char>,
+          double,
+        )
+      >();
+
+  int vtz_merged_lines_count(ffi.Pointer<VtzMergedLinesHandle> lines_handle) {
+    return _vtz_merged_lines_count(lines_handle);
+  }
+
+  late final _vtz_merged_lines_countPtr =
+      _lookup<
+        ffi.NativeFunction<ffi.Size Function(ffi.Pointer<VtzMergedLinesHandle>)>
+      >('vtz_merged_lines_count');
+  late final _vtz_merged_lines_count = _vtz_merged_lines_countPtr
+      .asFunction<int Function(ffi.Pointer<VtzMergedLinesHandle>)>();
+
+  /// x, y pairs of all lines in world coordinates (origin top-left, y down)
+  ffi.Pointer<ffi.Double> vtz_merged_lines_coordinates(
+    ffi.Pointer<VtzMergedLinesHandle> lines_handle,
+  ) {
+    return _vtz_merged_lines_coordinates(lines_handle);
+  }
+
+  late final _vtz_merged_lines_coordinatesPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Pointer<ffi.Double> Function(ffi.Pointer<VtzMergedLinesHandle>)
+        >
+      >('vtz_merged_lines_coordinates');
+  late final _vtz_merged_lines_coordinates = _vtz_merged_lines_coordinatesPtr
+      .asFunction<
+        ffi.Pointer<ffi.Double> Function(ffi.Pointer<VtzMergedLinesHandle>)
+      >();
+
+  /// count + 1 point offsets; line i spans points [offsets[i], offsets[i + 1])
+  ffi.Pointer<ffi.Uint32> vtz_merged_lines_offsets(
+    ffi.Pointer<VtzMergedLinesHandle> lines_handle,
+  ) {
+    return _vtz_merged_lines_offsets(lines_handle);
+  }
+
+  late final _vtz_merged_lines_offsetsPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Pointer<ffi.Uint32> Function(ffi.Pointer<VtzMergedLinesHandle>)
+        >
+      >('vtz_merged_lines_offsets');
+  late final _vtz_merged_lines_offsets = _vtz_merged_lines_offsetsPtr
+      .asFunction<
+        ffi.Pointer<ffi.Uint32> Function(ffi.Pointer<VtzMergedLinesHandle>)
+      >();
+
+  /// Number of clipped input pieces joined into line i
+  int vtz_merged_lines_piece_count(
+    ffi.Pointer<VtzMergedLinesHandle> lines_handle,
+    int index,
+  ) {
+    return _vtz_merged_lines_piece_count(lines_handle, index);
+  }
+
+  late final _vtz_merged_lines_piece_countPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Uint32 Function(ffi.Pointer<VtzMergedLinesHandle>, ffi.Size)
+        >
+      >('vtz_merged_lines_piece_count');
+  late final _vtz_merged_lines_piece_count = _vtz_merged_lines_piece_countPtr
+      .asFunction<int Function(ffi.Pointer<VtzMergedLinesHandle>, int)>();
+
+  /// Merge key of line i (property value or id as text, empty for VTZ_MERGE_KEY_LAYER or unkeyed lines)
+  ffi.Pointer<ffi.Char> vtz_merged_lines_key(
+    ffi.Pointer<VtzMergedLinesHandle> lines_handle,
+    int index,
+  ) {
+    return _vtz_merged_lines_key(lines_handle, index);
+  }
+
+  late final _vtz_merged_lines_keyPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Pointer<ffi.Char> Function(
+            ffi.Pointer<VtzMergedLinesHandle>,
+            ffi.Size,
+          )
+        >
+      >('vtz_merged_lines_key');
+  late final _vtz_merged_lines_key = _vtz_merged_lines_keyPtr
+      .asFunction<
+        ffi.Pointer<ffi.Char> Function(ffi.Pointer<VtzMergedLinesHandle>, int)
+      >();
+
+  /// World size in world units: largest extent * 2^max_zoom
+  double vtz_merged_lines_world_size(
+    ffi.Pointer<VtzMergedLinesHandle> lines_handle,
+  ) {
+    return _vtz_merged_lines_world_size(lines_handle);
+  }
+
+  late final _vtz_merged_lines_world_sizePtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Double Function(ffi.Pointer<VtzMergedLinesHandle>)
+        >
+      >('vtz_merged_lines_world_size');
+  late final _vtz_merged_lines_world_size = _vtz_merged_lines_world_sizePtr
+      .asFunction<double Function(ffi.Pointer<VtzMergedLinesHandle>)>();
+
+  void vtz_merged_lines_free(ffi.Pointer<VtzMergedLinesHandle> lines_handle) {
+    return _vtz_merged_lines_free(lines_handle);
+  }
+
+  late final _vtz_merged_lines_freePtr =
+      _lookup<
+        ffi.NativeFunction<ffi.Void Function(ffi.Pointer<VtzMergedLinesHandle>)>
+      >('vtz_merged_lines_free');
+  late final _vtz_merged_lines_free = _vtz_merged_lines_freePtr
+      .asFunction<void Function(ffi.Pointer<VtzMergedLinesHandle>)>();
+
+  /// Compact geometry store
+  /// Parts match vtz_feature_decode_geometry: all points of a (multi)point form one part, polygon
+  /// rings include the closing point. Features with invalid geometry are stored without parts.
+  ffi.Pointer<VtzGeometryStoreHandle> vtz_geometry_store_create(
+    ffi.Pointer<VtzTileHandle> tile_handle,
+  ) {
+    return _vtz_geometry_store_create(tile_handle);
+  }
+
+  late final _vtz_geometry_store_createPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Pointer<VtzGeometryStoreHandle> Function(
+            ffi.Pointer<VtzTileHandle>,
+          )
+        >
+      >('vtz_geometry_store_create');
+  late final _vtz_geometry_store_create = _vtz_geometry_store_createPtr
+      .asFunction<
+        ffi.Pointer<VtzGeometryStoreHandle> Function(ffi.Pointer<VtzTileHandle>)
+      >();
+
+  /// Builds the same store with thread_count worker threads (0 uses the hardware concurrency). The
+  /// tile's features are split into ranges balanced by size, so large layers are spread over
+  /// several workers; each worker encodes into its own buffers, which are joined in tile order.
+  ffi.Pointer<VtzGeometryStoreHandle> vtz_geometry_store_create_parallel(
+    ffi.Pointer<VtzTileHandle> tile_handle,
+    int thread_count,
+  ) {
+    return _vtz_geometry_store_create_parallel(tile_handle, thread_count);
+  }
+
+  late final _vtz_geometry_store_create_parallelPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Pointer<VtzGeometryStoreHandle> Function(
+            ffi.Pointer<VtzTileHandle>,
+            ffi.Uint32,
+          )
+        >
+      >('vtz_geometry_store_create_parallel');
+  late final _vtz_geometry_store_create_parallel =
+      _vtz_geometry_store_create_parallelPtr
+          .asFunction<
+            ffi.Pointer<VtzGeometryStoreHandle> Function(
+              ffi.Pointer<VtzTileHandle>,
+              int,
+            )
+          >();
+
+  int vtz_geometry_store_layer_count(
+    ffi.Pointer<VtzGeometryStoreHandle> store_handle,
+  ) {
+    return _vtz_geometry_store_layer_count(store_handle);
+  }
+
+  late final _vtz_geometry_store_layer_countPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Size Function(ffi.Pointer<VtzGeometryStoreHandle>)
+        >
+      >('vtz_geometry_store_layer_count');
+  late final _vtz_geometry_store_layer_count =
+      _vtz_geometry_store_layer_countPtr
+          .asFunction<int Function(ffi.Pointer<VtzGeometryStoreHandle>)>();
+
+  VtzGeometryStoreLayer vtz_geometry_store_layer(
+    ffi.Pointer<VtzGeometryStoreHandle> store_handle,
+    int index,
+  ) {
+    return _vtz_geometry_store_layer(store_handle, index);
+  }
+
+  late final _vtz_geometry_store_layerPtr =
+      _lookup<
+        ffi.NativeFunction<
+          VtzGeometryStoreLayer Function(
+            ffi.Pointer<VtzGeometryStoreHandle>,
+            ffi.Size,
+          )
+        >
+      >('vtz_geometry_store_layer');
+  late final _vtz_geometry_store_layer = _vtz_geometry_store_layerPtr
+      .asFunction<
+        VtzGeometryStoreLayer Function(ffi.Pointer<VtzGeometryStoreHandle>, int)
+      >();
+
+  int vtz_geometry_store_feature_count(
+    ffi.Pointer<VtzGeometryStoreHandle> store_handle,
+  ) {
+    return _vtz_geometry_store_feature_count(store_handle);
+  }
+
+  late final _vtz_geometry_store_feature_countPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Size Function(ffi.Pointer<VtzGeometryStoreHandle>)
+        >
+      >('vtz_geometry_store_feature_count');
+  late final _vtz_geometry_store_feature_count =
+      _vtz_geometry_store_feature_countPtr
+          .asFunction<int Function(ffi.Pointer<VtzGeometryStoreHandle>)>();
+
+  VtzGeometryStoreFeature vtz_geometry_store_feature(
+    ffi.Pointer<VtzGeometryStoreHandle> store_handle,
+    int index,
+  ) {
+    return _vtz_geometry_store_feature(store_handle, index);
+  }
+
+  late final _vtz_geometry_store_featurePtr =
+      _lookup<
+        ffi.NativeFunction<
+          VtzGeometryStoreFeature Function(
+            ffi.Pointer<VtzGeometryStoreHandle>,
+            ffi.Size,
+          )
+        >
+      >('vtz_geometry_store_feature');
+  late final _vtz_geometry_store_feature = _vtz_geometry_store_featurePtr
+      .asFunction<
+        VtzGeometryStoreFeature Function(
+          ffi.Pointer<VtzGeometryStoreHandle>,
+          int,
+        )
+      >();
+
+  /// Writes the first capacity of the feature's part_count + 1 point offsets to out and returns
+  /// part_count + 1
+  int vtz_geometry_store_part_offsets(
+    ffi.Pointer<VtzGeometryStoreHandle> store_handle,
+    int index,
+    ffi.Pointer<ffi.Uint32> out,
+    int capacity,
+  ) {
+    return _vtz_geometry_store_part_offsets(store_handle, index, out, capacity);
+  }
+
+  late final _vtz_geometry_store_part_offsetsPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Size Function(
+            ffi.Pointer<VtzGeometryStoreHandle>,
+            ffi.Size,
+            ffi.Pointer<ffi.Uint32>,
+            ffi.Size,
+          )
+        >
+      >('vtz_geometry_store_part_offsets');
+  late final _vtz_geometry_store_part_offsets =
+      _vtz_geometry_store_part_offsetsPtr
+          .asFunction<
+            int Function(
+              ffi.Pointer<VtzGeometryStoreHandle>,
+              int,
+              ffi.Pointer<ffi.Uint32>,
+              int,
+            )
+          >();
+
+  /// Writes x, y tile coordinates of the first capacity points of parts [part_begin, part_end) to
+  /// out (room for capacity pairs) and returns the point count of those parts
+  int vtz_geometry_store_decode(
+    ffi.Pointer<VtzGeometryStoreHandle> store_handle,
+    int index,
+    int part_begin,
+    int part_end,
+    ffi.Pointer<ffi.Int32> out,
+    int capacity,
+  ) {
+    return _vtz_geometry_store_decode(
+      store_handle,
+      index,
+      part_begin,
+      part_end,
+      out,
+      capacity,
+    );
+  }
+
+  late final _vtz_geometry_store_decodePtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Size Function(
+            ffi.Pointer<VtzGeometryStoreHandle>,
+            ffi.Size,
+            ffi.Uint32,
+            ffi.Uint32,
+            ffi.Pointer<ffi.Int32>,
+            ffi.Size,
+          )
+        >
+      >('vtz_geometry_store_decode');
+  late final _vtz_geometry_store_decode = _vtz_geometry_store_decodePtr
+      .asFunction<
+        int Function(
+          ffi.Pointer<VtzGeometryStoreHandle>,
+          int,
+          int,
+          int,
+          ffi.Pointer<ffi.Int32>,
+          int,
+        )
+      >();
+
+  /// Like vtz_geometry_store_decode, projected to lon, lat pairs (Web Mercator) for tile z/x/y
+  int vtz_geometry_store_project(
+    ffi.Pointer<VtzGeometryStoreHandle> store_handle,
+    int index,
+    int part_begin,
+    int part_end,
+    int tile_z,
+    int tile_x,
+    int tile_y,
+    ffi.Pointer<ffi.Double> out,
+    int capacity,
+  ) {
+    return _vtz_geometry_store_project(
+      store_handle,
+      index,
+      part_begin,
+      part_end,
+      tile_z,
+      tile_x,
+      tile_y,
+      out,
+      capacity,
+    );
+  }
+
+  late final _vtz_geometry_store_projectPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Size Function(
+            ffi.Pointer<VtzGeometryStoreHandle>,
+            ffi.Size,
+            ffi.Uint32,
+            ffi.Uint32,
+            ffi.Uint32,
+            ffi.Uint32,
+            ffi.Uint32,
+            ffi.Pointer<ffi.Double>,
+            ffi.Size,
+          )
+        >
+      >('vtz_geometry_store_project');
+  late final _vtz_geometry_store_project = _vtz_geometry_store_projectPtr
+      .asFunction<
+        int Function(
+          ffi.Pointer<VtzGeometryStoreHandle>,
+          int,
+          int,
+          int,
+          int,
+          int,
+          int,
+          ffi.Pointer<ffi.Double>,
+          int,
+        )
+      >();
+
+  /// Bytes held by the store
+  int vtz_geometry_store_byte_size(
+    ffi.Pointer<VtzGeometryStoreHandle> store_handle,
+  ) {
+    return _vtz_geometry_store_byte_size(store_handle);
+  }
+
+  late final _vtz_geometry_store_byte_sizePtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Size Function(ffi.Pointer<VtzGeometryStoreHandle>)
+        >
+      >('vtz_geometry_store_byte_size');
+  late final _vtz_geometry_store_byte_size = _vtz_geometry_store_byte_sizePtr
+      .asFunction<int Function(ffi.Pointer<VtzGeometryStoreHandle>)>();
+
+  void vtz_geometry_store_free(
+    ffi.Pointer<VtzGeometryStoreHandle> store_handle,
+  ) {
+    return _vtz_geometry_store_free(store_handle);
+  }
+
+  late final _vtz_geometry_store_freePtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Void Function(ffi.Pointer<VtzGeometryStoreHandle>)
+        >
+      >('vtz_geometry_store_free');
+  late final _vtz_geometry_store_free = _vtz_geometry_store_freePtr
+      .asFunction<void Function(ffi.Pointer<VtzGeometryStoreHandle>)>();
+
+  /// Incremental decoding
+  /// A session decodes a tile into a geometry store a slice at a time, keeping its layer and
+  /// feature cursor between calls, so a large tile can be decoded across several frames. The
+  /// tile handle must outlive the session.
+  ffi.Pointer<VtzDecodeSessionHandle> vtz_decode_session_create(
+    ffi.Pointer<VtzTileHandle> tile_handle,
+  ) {
+    return _vtz_decode_session_create(tile_handle);
+  }
+
+  late final _vtz_decode_session_createPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Pointer<VtzDecodeSessionHandle> Function(
+            ffi.Pointer<VtzTileHandle>,
+          )
+        >
+      >('vtz_decode_session_create');
+  late final _vtz_decode_session_create = _vtz_decode_session_createPtr
+      .asFunction<
+        ffi.Pointer<VtzDecodeSessionHandle> Function(ffi.Pointer<VtzTileHandle>)
+      >();
+
+  /// Decodes features until budget_us microseconds have passed or max_features were decoded (0 for
+  /// no limit), and at least one feature. Returns the number of features added to the store by this
+  /// call. A malformed layer sets the exception and ends the session.
+  int vtz_decode_session_step(
+    ffi.Pointer<VtzDecodeSessionHandle> session_handle,
+    int budget_us,
+    int max_features,
+  ) {
+    return _vtz_decode_session_step(session_handle, budget_us, max_features);
+  }
+
+  late final _vtz_decode_session_stepPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Size Function(
+            ffi.Pointer<VtzDecodeSessionHandle>,
+            ffi.Uint32,
+            ffi.Uint32,
+          )
+        >
+      >('vtz_decode_session_step');
+  late final _vtz_decode_session_step = _vtz_decode_session_stepPtr
+      .asFunction<int Function(ffi.Pointer<VtzDecodeSessionHandle>, int, int)>();
+
+  bool vtz_decode_session_done(
+    ffi.Pointer<VtzDecodeSessionHandle> session_handle,
+  ) {
+    return _vtz_decode_session_done(session_handle);
+  }
+
+  late final _vtz_decode_session_donePtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<VtzDecodeSessionHandle>)
+        >
+      >('vtz_decode_session_done');
+  late final _vtz_decode_session_done = _vtz_decode_session_donePtr
+      .asFunction<bool Function(ffi.Pointer<VtzDecodeSessionHandle>)>();
+
+  /// Store with everything decoded so far, owned by the session. Features are appended in tile
+  /// order and the last layer's feature_count grows until the session moves past it.
+  ffi.Pointer<VtzGeometryStoreHandle> vtz_decode_session_store(
+    ffi.Pointer<VtzDecodeSessionHandle> session_handle,
+  ) {
+    return _vtz_decode_session_store(session_handle);
+  }
+
+  late final _vtz_decode_session_storePtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Pointer<VtzGeometryStoreHandle> Function(
+            ffi.Pointer<VtzDecodeSessionHandle>,
+          )
+        >
+      >('vtz_decode_session_store');
+  late final _vtz_decode_session_store = _vtz_decode_session_storePtr
+      .asFunction<
+        ffi.Pointer<VtzGeometryStoreHandle> Function(
+          ffi.Pointer<VtzDecodeSessionHandle>,
+        )
+      >();
+
+  void vtz_decode_session_free(
+    ffi.Pointer<VtzDecodeSessionHandle> session_handle,
+  ) {
+    return _vtz_decode_session_free(session_handle);
+  }
+
+  late final _vtz_decode_session_freePtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Void Function(ffi.Pointer<VtzDecodeSessionHandle>)
+        >
+      >('vtz_decode_session_free');
+  late final _vtz_decode_session_free = _vtz_decode_session_freePtr
+      .asFunction<void Function(ffi.Pointer<VtzDecodeSessionHandle>)>();
+
+  /// Exception handling
+  int vtz_get_last_exception_type() {
+    return _vtz_get_last_exception_type();
+  }
+
+  late final _vtz_get_last_exception_typePtr =
+      _lookup<ffi.NativeFunction<ffi.Int32 Function()>>(
+        'vtz_get_last_exception_type',
+      );
+  late final _vtz_get_last_exception_type = _vtz_get_last_exception_typePtr
+      .asFunction<int Function()>();
+
+  ffi.Pointer<ffi.Char> vtz_get_last_exception_message() {
+    return _vtz_get_last_exception_message();
+  }
+
+  late final _vtz_get_last_exception_messagePtr =
+      _lookup<ffi.NativeFunction<ffi.Pointer<ffi.Char> Function()>>(
+        'vtz_get_last_exception_message',
+      );
+  late final _vtz_get_last_exception_message =
+      _vtz_get_last_exception_messagePtr
+          .asFunction<ffi.Pointer<ffi.Char> Function()>();
+
+  void vtz_clear_exception() {
+    return _vtz_clear_exception();
+  }
+
+  late final _vtz_clear_exceptionPtr =
+      _lookup<ffi.NativeFunction<ffi.Void Function()>>('vtz_clear_exception');
+  late final _vtz_clear_exception = _vtz_clear_exceptionPtr
+      .asFunction<void Function()>();
+
+  void vtz_stats_snapshot(ffi.Pointer<VtzStatsSnapshot> out) {
+    return _vtz_stats_snapshot(out);
+  }
+
+  late final _vtz_stats_snapshotPtr =
+      _lookup<
+        ffi.NativeFunction<ffi.Void Function(ffi.Pointer<VtzStatsSnapshot>)>
+      >('vtz_stats_snapshot');
+  late final _vtz_stats_snapshot = _vtz_stats_snapshotPtr
+      .asFunction<void Function(ffi.Pointer<VtzStatsSnapshot>)>();
+
+  /// Resets call counters, histograms and totals; live handle counts are kept
+  void vtz_stats_reset() {
+    return _vtz_stats_reset();
+  }
+
+  late final _vtz_stats_resetPtr =
+      _lookup<ffi.NativeFunction<ffi.Void Function()>>('vtz_stats_reset');
+  late final _vtz_stats_reset = _vtz_stats_resetPtr
+      .asFunction<void Function()>();
+}
+
+/// Exception type enum
+enum VtzExceptionType {
+  none(0),
+  format(1),
+  geometry(2),
+  type(3),
+  version(4),
+  outOfRange(5);
+
+  final int value;
+  const VtzExceptionType(this.value);
+
+  static VtzExceptionType fromInt(int value) {
+    switch (value) {
+      case 0:
+        return VtzExceptionType.none;
+      case 1:
+        return VtzExceptionType.format;
+      case 2:
+        return VtzExceptionType.geometry;
+      case 3:
+        return VtzExceptionType.type;
+      case 4:
+        return VtzExceptionType.version;
+      case 5:
+        return VtzExceptionType.outOfRange;
+      default:
+        return VtzExceptionType.none;
+    }
+  }
+}
+
+final class VtzTileHandle extends ffi.Opaque {}
+
+final class VtzLayerHandle extends ffi.Opaque {}
 
 final class VtzFeatureHandle extends ffi.Opaque {}
 
+/// Tile cache operations
+/// A thread-safe, sharded LRU cache of decoded tile data keyed by (source, z, x, y).
+/// Tile handles returned by get/put share the cached buffer and pin the entry until
+/// freed with vtz_tile_free, so tiles in use are never evicted.
+final class VtzTileCacheHandle extends ffi.Opaque {}
+
+final class VtzTileCacheStats extends ffi.Struct {
+  @ffi.Uint64()
+  external int hits;
+
+  @ffi.Uint64()
+  external int misses;
+
+  @ffi.Uint64()
+  external int evictions;
+
+  @ffi.Uint64()
+  external int entries;
+
+  @ffi.Uint64()
+  external int pinned;
+
+  @ffi.Uint64()
+  external int bytes;
+
+  @ffi.Uint64()
+  external int byte_budget;
+}
+
 final class VtzPropertyValueHandle extends ffi.Opaque {}
 
 /// Property iteration callback
@@ -689,3 +1736,316 @@ typedef DartGeoJsonCallbackFunction =
       double lon,
       double lat,
     );
+
+/// Projected geometry decoding
+/// Decodes a feature's geometry straight into caller provided arrays in the requested coordinate
+/// system. Parts match vtz_feature_decode_geometry. The Web Mercator projections use extent and
+/// the tile z/x/y, the screen projection only the affine coefficients.
+enum VtzProjectionKind {
+  /// Tile coordinates
+  tile(0),
+
+  /// EPSG:3857 meters
+  webMercatorMeters(1),
+
+  /// Longitude, latitude as in vtz_feature_to_geojson
+  wgs84(2),
+
+  /// Affine transform of tile coordinates
+  screen(3);
+
+  final int value;
+  const VtzProjectionKind(this.value);
+}
+
+final class VtzProjectionParams extends ffi.Struct {
+  @ffi.Uint32()
+  external int extent;
+
+  @ffi.Uint32()
+  external int tile_z;
+
+  @ffi.Uint32()
+  external int tile_x;
+
+  @ffi.Uint32()
+  external int tile_y;
+
+  /// {a, b, c, d, e, f}: x' = a*x + b*y + c, y' = d*x + e*y + f
+  @ffi.Array.multi([6])
+  external ffi.Array<ffi.Double> affine;
+}
+
+final class VtzProjectedGeometry extends ffi.Struct {
+  /// Room for point_capacity x, y pairs
+  external ffi.Pointer<ffi.Double> coordinates;
+
+  @ffi.Size()
+  external int point_capacity;
+
+  /// Room for part_capacity offsets, the first point of each part
+  external ffi.Pointer<ffi.Uint32> part_offsets;
+
+  @ffi.Size()
+  external int part_capacity;
+
+  /// Set to the full size of the geometry; when it exceeds the
+  @ffi.Size()
+  external int point_count;
+
+  /// capacities only what fits is written
+  @ffi.Size()
+  external int part_count;
+}
+
+/// Label anchors
+enum VtzLabelAnchorKind {
+  /// Pole of inaccessibility of each polygon
+  polylabel(0),
+
+  /// Area-weighted (polygons), length-weighted (lines) or mean (points) centroid
+  centroid(1),
+
+  /// Evenly spaced anchors along each linestring with tangent angles
+  line(2);
+
+  final int value;
+  const VtzLabelAnchorKind(this.value);
+}
+
+final class VtzLabelAnchor extends ffi.Struct {
+  /// Position in tile coordinates
+  @ffi.Double()
+  external double x;
+
+  @ffi.Double()
+  external double y;
+
+  /// Line tangent in radians, atan2(dy, dx) in tile coordinates; 0 otherwise
+  @ffi.Double()
+  external double angle;
+
+  /// Polylabel: distance to the outline, centroid: area/length/point count, line: part length
+  @ffi.Double()
+  external double weight;
+
+  /// Feature position in the layer, 0 for single feature anchors
+  @ffi.Uint32()
+  external int feature_index;
+
+  /// Polygon or linestring index within the feature
+  @ffi.Uint32()
+  external int part_index;
+}
+
+final class VtzLabelAnchorsHandle extends ffi.Opaque {}
+
+/// Cross-tile line merging
+/// Joins linestrings cut at tile boundaries back into continuous lines. Lines are clipped to
+/// their tile, converted to a shared world space (the deepest input zoom, largest extent), and
+/// pieces of the same merge group whose endpoints on a tile edge coincide within the tolerance
+/// are chained. Pieces may be reversed to join them.
+final class VtzMergeTile extends ffi.Struct {
+  external ffi.Pointer<VtzTileHandle> tile;
+
+  @ffi.Uint32()
+  external int z;
+
+  @ffi.Uint32()
+  external int x;
+
+  @ffi.Uint32()
+  external int y;
+}
+
+enum VtzMergeKeyKind {
+  /// All lines of the layer may be joined
+  layer(0),
+
+  /// Only lines with the same value of property_key
+  property(1),
+
+  /// Only lines with the same feature id
+  featureId(2);
+
+  final int value;
+  const VtzMergeKeyKind(this.value);
+}
+
+final class VtzMergedLinesHandle extends ffi.Opaque {}
+
+/// Compact geometry store
+/// Decodes the geometry of every feature of a tile once into zigzag-delta encoded tile
+/// coordinates with part offsets. Deltas are stored in 16 bits per value where a feature's
+/// deltas fit and 32 bits otherwise; each part restarts from absolute coordinates so parts
+/// decode independently. The store copies what it needs and can outlive the tile handle.
+final class VtzGeometryStoreHandle extends ffi.Opaque {}
+
+final class VtzGeometryStoreLayer extends ffi.Struct {
+  /// Owned by the store
+  external ffi.Pointer<ffi.Char> name;
+
+  @ffi.Uint32()
+  external int extent;
+
+  /// Store index of the layer's first feature
+  @ffi.Uint32()
+  external int first_feature;
+
+  @ffi.Uint32()
+  external int feature_count;
+}
+
+final class VtzGeometryStoreFeature extends ffi.Struct {
+  /// 0=unknown, 1=point, 2=linestring, 3=polygon
+  @ffi.Uint32()
+  external int geometry_type;
+
+  @ffi.Uint32()
+  external int layer_index;
+
+  /// 0 for features with invalid geometry
+  @ffi.Uint32()
+  external int part_count;
+
+  @ffi.Uint32()
+  external int point_count;
+}
+
+/// Incremental decoding
+final class VtzDecodeSessionHandle extends ffi.Opaque {}
+
+/// Instrumentation
+/// Compiled in only when the library is built with VTZ_ENABLE_STATS
+/// (CMake option VTZERO_DART_ENABLE_STATS), otherwise all counters stay zero.
+///
+/// Call counter index for each exported function
+enum VtzStatsFunction {
+  tileCreate(0),
+  tileCreateCompressed(1),
+  tileFree(2),
+  tileNextLayer(3),
+  tileGetLayerByName(4),
+  tileCacheCreate(5),
+  tileCacheFree(6),
+  tileCacheGet(7),
+  tileCachePut(8),
+  tileCacheRemove(9),
+  tileCacheClear(10),
+  tileCacheStats(11),
+  layerFree(12),
+  layerName(13),
+  layerExtent(14),
+  layerVersion(15),
+  layerNextFeature(16),
+  layerValueTableSize(17),
+  layerValue(18),
+  propertyValueFree(19),
+  propertyValueType(20),
+  propertyValueString(21),
+  propertyValueFloat(22),
+  propertyValueDouble(23),
+  propertyValueInt(24),
+  propertyValueUint(25),
+  propertyValueSint(26),
+  propertyValueBool(27),
+  featureFree(28),
+  featureGeometryType(29),
+  featureHasId(30),
+  featureId(31),
+  featureForEachProperty(32),
+  featureNextPropertyIndexes(33),
+  featureResetProperty(34),
+  featureForEachPropertyIndexes(35),
+  featureDecodeGeometry(36),
+  featureToGeojson(37),
+  getLastExceptionType(38),
+  getLastExceptionMessage(39),
+  clearException(40),
+  featureLabelAnchors(41),
+  layerLabelAnchors(42),
+  labelAnchorsCount(43),
+  labelAnchorsData(44),
+  labelAnchorsFree(45),
+  layerBuildFeatureIndex(46),
+  layerGetFeatureById(47),
+  layerGetFeaturesByIds(48),
+  mergeLines(49),
+  mergedLinesCount(50),
+  mergedLinesCoordinates(51),
+  mergedLinesOffsets(52),
+  mergedLinesPieceCount(53),
+  mergedLinesKey(54),
+  mergedLinesWorldSize(55),
+  mergedLinesFree(56),
+  geometryStoreCreate(57),
+  geometryStoreLayerCount(58),
+  geometryStoreLayer(59),
+  geometryStoreFeatureCount(60),
+  geometryStoreFeature(61),
+  geometryStorePartOffsets(62),
+  geometryStoreDecode(63),
+  geometryStoreProject(64),
+  geometryStoreByteSize(65),
+  geometryStoreFree(66),
+  geometryStoreCreateParallel(67),
+  decodeSessionCreate(68),
+  decodeSessionStep(69),
+  decodeSessionDone(70),
+  decodeSessionStore(71),
+  decodeSessionFree(72),
+  featureDecodeProjected(73),
+  tileHash(74),
+  layerHash(75),
+  layerFeatureHashes(76);
+
+  final int value;
+  const VtzStatsFunction(this.value);
+}
+
+/// Heavy paths with latency histograms
+enum VtzStatsLatency {
+  tileCreate(0),
+  geometryDecode(1),
+  geojson(2),
+  propertyIteration(3);
+
+  final int value;
+  const VtzStatsLatency(this.value);
+}
+
+final class VtzStatsSnapshot extends ffi.Struct {
+  @ffi.Bool()
+  external bool enabled;
+
+  @ffi.Array.multi([77])
+  external ffi.Array<ffi.Uint64> calls;
+
+  @ffi.Array.multi([4])
+  external ffi.Array<ffi.Uint64> latency_total_ns;
+
+  @ffi.Array.multi([4, 40])
+  external ffi.Array<ffi.Array<ffi.Uint64>> latency_histogram;
+
+  /// Tile bytes passed to tile create functions
+  @ffi.Uint64()
+  external int bytes_processed;
+
+  /// Points produced by geometry decoding and GeoJSON conversion
+  @ffi.Uint64()
+  external int vertices_emitted;
+
+  @ffi.Int64()
+  external int live_tiles;
+
+  @ffi.Int64()
+  external int live_layers;
+
+  @ffi.Int64()
+  external int live_features;
+
+  @ffi.Int64()
+  external int live_property_values;
+}
+
+const int VTZ_STATS_LATENCY_BUCKETS = 40;
@@ -0,0 +1,131 @@
+// ignore_for_file: avoid_print
+
+import 'dart:io';
+import 'dart:typed_data';
+import 'package:vtzero_dart/vtzero_dart.dart';
+
+/// Number of times each tile is decoded per implementation
+const int _iterations = 200;
+
+/// Benchmark comparing Dart-side gzip inflate + copy with native inflate
+///
+/// Uses the test fixtures, so no tiles need to be downloaded first.
+Future<void> main() async {
+  final tileFiles = <File>[
+    ...Directory('test/fixtures')
+        .listSync()
+        .whereType<Directory>()
+        .map((dir) => File('${dir.path}/tile.mvt'))
+        .where((file) => file.existsSync()),
+    File('test/data/chart.pbf'),
+  ];
+
+  // Only keep tiles that decode, and store them gzip compressed as servers do
+  final tiles = <MapEntry<String, Uint8List>>[];
+  for (final file in tileFiles) {
+    final bytes = file.readAsBytesSync();
+    try {
+      VtzTile.fromBytes(bytes)
+        ..getLayers()
+        ..dispose();
+    } catch (_) {
+      continue;
+    }
+    tiles.add(MapEntry(file.path, Uint8List.fromList(gzip.encode(bytes))));
+  }
+
+  if (tiles.isEmpty) {
+    print('Error: No valid tiles found in test/fixtures.');
+    exit(1);
+  }
+
+  print('Loaded ${tiles.length} gzip compressed tiles');
+  print('Running $_iterations iterations per tile...\n');
+
+  // Warmup runs to avoid JIT compilation affecting results
+  _benchmarkDartInflate(tiles, 10);
+  _benchmarkNativeInflate(tiles, 10);
+
+  final dartTimes = _benchmarkDartInflate(tiles, _iterations);
+  final nativeTimes = _benchmarkNativeInflate(tiles, _iterations);
+
+  print('=' * 80);
+  print('COMPRESSED TILE DECODING');
+  print('=' * 80);
+  print('');
+  print('Dart inflate + copy (gzip.decode + VtzTile.fromBytes):');
+  _printStats(dartTimes);
+  print('');
+  print('Native inflate (VtzTile.fromCompressedBytes):');
+  _printStats(nativeTimes);
+  print('');
+
+  final dartMean = dartTimes.reduce((a, b) => a + b) / dartTimes.length;
+  final nativeMean = nativeTimes.reduce((a, b) => a + b) / nativeTimes.length;
+  final speedup = dartMean / nativeMean;
+  if (speedup > 1) {
+    print('Native inflate is ${speedup.toStringAsFixed(2)}x faster');
+  } else {
+    print('Dart inflate is ${(1 / speedup).toStringAsFixed(2)}x faster');
+  }
+}
+
+/// Decode tiles by inflating on the Dart heap and copying into native memory
+List<int> _benchmarkDartInflate(
+  List<MapEntry<String, Uint8List>> tiles,
+  int iterations,
+) {
+  final times = <int>[];
+  final stopwatch = Stopwatch();
+
+  for (var i = 0; i < iterations; i++) {
+    for (final tile in tiles) {
+      stopwatch
+        ..reset()
+        ..start();
+      final bytes = Uint8List.fromList(gzip.decode(tile.value));
+      final vtzTile = VtzTile.fromBytes(bytes);
+      stopwatch.stop();
+      times.add(stopwatch.elapsedMicroseconds);
+      vtzTile.dispose();
+    }
+  }
+
+  return times;
+}
+
+/// Decode tiles by inflating natively into the tile buffer
+List<int> _benchmarkNativeInflate(
+  List<MapEntry<String, Uint8List>> tiles,
+  int iterations,
+) {
+  final times = <int>[];
+  final stopwatch = Stopwatch();
+
+  for (var i = 0; i < iterations; i++) {
+    for (final tile in tiles) {
+      stopwatch
+        ..reset()
+        ..start();
+      final vtzTile = VtzTile.fromCompressedBytes(tile.value);
+      stopwatch.stop();
+      times.add(stopwatch.elapsedMicroseconds);
+      vtzTile.dispose();
+    }
+  }
+
+  return times;
+}
+
+/// Print statistics for a list of times (in microseconds)
+void _printStats(List<int> times) {
+  times.sort();
+  final mean = times.reduce((a, b) => a + b) / times.length;
+
+  print('  Samples: ${times.length}');
+  print('  Min:     ${times.first}μs');
+  print('  Max:     ${times.last}μs');
+  print('  Mean:    ${mean.toStringAsFixed(1)}μs');
+  print('  Median:  ${times[times.length ~/ 2]}μs');
+  print('  P99:     ${times[(times.length * 0.99).floor()]}μs');
+}
@@ -37,10 +37,43 @@ typedef struct VtzFeatureHandle VtzFeatureHandle;
 
 // Tile operations
 FFI_PLUGIN_EXPORT VtzTileHandle* vtz_tile_create(const uint8_t* data, size_t length);
+// Create a tile from gzip or zlib compressed data, inflating natively into the tile's buffer.
+// Uncompressed data is accepted and copied as with vtz_tile_create.
+FFI_PLUGIN_EXPORT VtzTileHandle* vtz_tile_create_compressed(const uint8_t* data, size_t length);
 FFI_PLUGIN_EXPORT void vtz_tile_free(VtzTileHandle* handle);
 FFI_PLUGIN_EXPORT VtzLayerHandle* vtz_tile_next_layer(VtzTileHandle* tile_handle);
 FFI_PLUGIN_EXPORT VtzLayerHandle* vtz_tile_get_layer_by_name(VtzTileHandle* tile_handle, const char* name);
 
+// Tile cache operations
+// A thread-safe, sharded LRU cache of decoded tile data keyed by (source, z, x, y).
+// Tile handles returned by get/put share the cached buffer and pin the entry until
+// freed with vtz_tile_free, so tiles in use are never evicted.
+typedef struct VtzTileCacheHandle VtzTileCacheHandle;
+
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    uint64_t entries;
+    uint64_t pinned;
+    uint64_t bytes;
+    uint64_t byte_budget;
+} VtzTileCacheStats;
+
+FFI_PLUGIN_EXPORT VtzTileCacheHandle* vtz_tile_cache_create(size_t byte_budget, uint32_t shard_count);
+FFI_PLUGIN_EXPORT void vtz_tile_cache_free(VtzTileCacheHandle* cache);
+// Returns a new tile handle on a hit, or NULL on a miss or error
+FFI_PLUGIN_EXPORT VtzTileHandle* vtz_tile_cache_get(VtzTileCacheHandle* cache, uint64_t source,
+                                                     uint32_t z, uint32_t x, uint32_t y);
+// Inserts tile data (inflating gzip/zlib data) and returns a tile handle for it
+FFI_PLUGIN_EXPORT VtzTileHandle* vtz_tile_cache_put(VtzTileCacheHandle* cache, uint64_t source,
+                                                     uint32_t z, uint32_t x, uint32_t y,
+                                                     const uint8_t* data, size_t length);
+FFI_PLUGIN_EXPORT bool vtz_tile_cache_remove(VtzTileCacheHandle* cache, uint64_t source,
+                                             uint32_t z, uint32_t x, uint32_t y);
+FFI_PLUGIN_EXPORT void vtz_tile_cache_clear(VtzTileCacheHandle* cache);
+FFI_PLUGIN_EXPORT VtzTileCacheStats vtz_tile_cache_stats(VtzTileCacheHandle* cache);
+
 // Layer operations
 FFI_PLUGIN_EXPORT void vtz_layer_free(VtzLayerHandle* handle);
 FFI_PLUGIN_EXPORT const char* vtz_layer_name(VtzLayerHandle* layer_handle);
@@ -48,6 +81,33 @@ FFI_PLUGIN_EXPORT uint32_t vtz_layer_extent(VtzLayerHandle* layer_handle);
 FFI_PLUGIN_EXPORT uint32_t vtz_layer_version(VtzLayerHandle* layer_handle);
 FFI_PLUGIN_EXPORT VtzFeatureHandle* vtz_layer_next_feature(VtzLayerHandle* layer_handle);
 
+// Feature id index
+// Builds (once) an id -> feature index for the layer, held by the tile handle and shared
+// by all layer handles of that tile. Returns the number of indexed ids.
+FFI_PLUGIN_EXPORT size_t vtz_layer_build_feature_index(VtzLayerHandle* layer_handle);
+// Looks up a feature by id with a hash probe if the index is built, otherwise by scanning the layer.
+// Does not move the layer's feature iterator. Returns NULL if there is no feature with that id.
+FFI_PLUGIN_EXPORT VtzFeatureHandle* vtz_layer_get_feature_by_id(VtzLayerHandle* layer_handle, uint64_t id);
+// Batch lookup: out_features[i] receives the feature for ids[i], or NULL if not found.
+// Without an index the layer is scanned once. Returns the number of features found.
+FFI_PLUGIN_EXPORT size_t vtz_layer_get_features_by_ids(VtzLayerHandle* layer_handle,
+                                                        const uint64_t* ids,
+                                                        size_t count,
+                                                        VtzFeatureHandle** out_features);
+
+// Content hashing
+// 64-bit XXH64 hashes of the raw message bytes, identical across runs and platforms, for cheap
+// change detection and as cache keys. Byte-identical messages hash equal; the same content
+// encoded differently does not. Feature messages refer to the layer's key and value tables by
+// index, so feature hashes only identify properties together with the layer's tables.
+FFI_PLUGIN_EXPORT uint64_t vtz_tile_hash(VtzTileHandle* tile_handle);
+FFI_PLUGIN_EXPORT uint64_t vtz_layer_hash(VtzLayerHandle* layer_handle);
+// Writes the hashes of the first capacity features in layer order and returns the number of
+// features in the layer. Does not move the layer's feature iterator.
+FFI_PLUGIN_EXPORT size_t vtz_layer_feature_hashes(VtzLayerHandle* layer_handle,
+                                                   uint64_t* out_hashes,
+                                                   size_t capacity);
+
 // Value table operations
 FFI_PLUGIN_EXPORT size_t vtz_layer_value_table_size(VtzLayerHandle* layer_handle);
 typedef struct VtzPropertyValueHandle VtzPropertyValueHandle;
@@ -112,11 +172,319 @@ FFI_PLUGIN_EXPORT void vtz_feature_to_geojson(VtzFeatureHandle* feature_handle,
                                                 GeoJsonCallback callback,
                                                 void* user_data);
 
+// Projected geometry decoding
+// Decodes a feature's geometry straight into caller provided arrays in the requested coordinate
+// system. Parts match vtz_feature_decode_geometry. The Web Mercator projections use extent and
+// the tile z/x/y, the screen projection only the affine coefficients.
+typedef enum {
+    VTZ_PROJECTION_TILE = 0,                 // Tile coordinates
+    VTZ_PROJECTION_WEB_MERCATOR_METERS = 1,  // EPSG:3857 meters
+    VTZ_PROJECTION_WGS84 = 2,                // Longitude, latitude as in vtz_feature_to_geojson
+    VTZ_PROJECTION_SCREEN = 3                // Affine transform of tile coordinates
+} VtzProjectionKind;
+
+typedef struct {
+    uint32_t extent;
+    uint32_t tile_z;
+    uint32_t tile_x;
+    uint32_t tile_y;
+    double affine[6];  // {a, b, c, d, e, f}: x' = a*x + b*y + c, y' = d*x + e*y + f
+} VtzProjectionParams;
+
+typedef struct {
+    double* coordinates;     // Room for point_capacity x, y pairs
+    size_t point_capacity;
+    uint32_t* part_offsets;  // Room for part_capacity offsets, the first point of each part
+    size_t part_capacity;
+    size_t point_count;      // Set to the full size of the geometry; when it exceeds the
+    size_t part_count;       // capacities only what fits is written
+} VtzProjectedGeometry;
+
+// Returns 0 on success, 1 on geometry errors and -1 on other errors
+FFI_PLUGIN_EXPORT int vtz_feature_decode_projected(VtzFeatureHandle* feature_handle,
+                                                   VtzProjectionKind projection_kind,
+                                                   const VtzProjectionParams* params,
+                                                   VtzProjectedGeometry* out);
+
+// Label anchors
+typedef enum {
+    VTZ_LABEL_ANCHOR_POLYLABEL = 0,  // Pole of inaccessibility of each polygon
+    VTZ_LABEL_ANCHOR_CENTROID = 1,   // Area-weighted (polygons), length-weighted (lines) or mean (points) centroid
+    VTZ_LABEL_ANCHOR_LINE = 2        // Evenly spaced anchors along each linestring with tangent angles
+} VtzLabelAnchorKind;
+
+typedef struct {
+    double x;                // Position in tile coordinates
+    double y;
+    double angle;            // Line tangent in radians, atan2(dy, dx) in tile coordinates; 0 otherwise
+    double weight;           // Polylabel: distance to the outline, centroid: area/length/point count, line: part length
+    uint32_t feature_index;  // Feature position in the layer, 0 for single feature anchors
+    uint32_t part_index;     // Polygon or linestring index within the feature
+} VtzLabelAnchor;
+
+typedef struct VtzLabelAnchorsHandle VtzLabelAnchorsHandle;
+
+// precision: polylabel precision in tile units (<= 0 uses 1)
+// count: anchors per linestring for VTZ_LABEL_ANCHOR_LINE, 1 gives the length-weighted midpoint
+// Features of a geometry type the kind does not apply to produce no anchors.
+// An unknown kind returns NULL with a geometry exception set.
+FFI_PLUGIN_EXPORT VtzLabelAnchorsHandle* vtz_feature_label_anchors(VtzFeatureHandle* feature_handle,
+                                                                    VtzLabelAnchorKind kind,
+                                                                    double precision,
+                                                                    uint32_t count);
+// Anchors for all features of a layer in one call; does not move the layer's feature iterator.
+// Features with invalid geometry are skipped.
+FFI_PLUGIN_EXPORT VtzLabelAnchorsHandle* vtz_layer_label_anchors(VtzLayerHandle* layer_handle,
+                                                                  VtzLabelAnchorKind kind,
+                                                                  double precision,
+                                                                  uint32_t count);
+FFI_PLUGIN_EXPORT size_t vtz_label_anchors_count(VtzLabelAnchorsHandle* anchors_handle);
+FFI_PLUGIN_EXPORT const VtzLabelAnchor* vtz_label_anchors_data(VtzLabelAnchorsHandle* anchors_handle);
+FFI_PLUGIN_EXPORT void vtz_label_anchors_free(VtzLabelAnchorsHandle* anchors_handle);
+
+// Cross-tile line merging
+// Joins linestrings cut at tile boundaries back into continuous lines. Lines are clipped to
+// their tile, converted to a shared world space (the deepest input zoom, largest extent), and
+// pieces of the same merge group whose endpoints on a tile edge coincide within the tolerance
+// are chained. Pieces may be reversed to join them.
+typedef struct {
+    VtzTileHandle* tile;
+    uint32_t z;
+    uint32_t x;
+    uint32_t y;
+} VtzMergeTile;
+
+typedef enum {
+    VTZ_MERGE_KEY_LAYER = 0,      // All lines of the layer may be joined
+    VTZ_MERGE_KEY_PROPERTY = 1,   // Only lines with the same value of property_key
+    VTZ_MERGE_KEY_FEATURE_ID = 2  // Only lines with the same feature id
+} VtzMergeKeyKind;
+
+typedef struct VtzMergedLinesHandle VtzMergedLinesHandle;
+
+// tolerance: maximum endpoint distance in world units. Lines without the key are returned unmerged.
+// An unknown key_kind returns NULL with an out of range exception set.
+FFI_PLUGIN_EXPORT VtzMergedLinesHandle* vtz_merge_lines(const VtzMergeTile* tiles,
+                                                        size_t tile_count,
+                                                        const char* layer_name,
+                                                        VtzMergeKeyKind key_kind,
+                                                        const char* property_key,
+                                                        double tolerance);
+FFI_PLUGIN_EXPORT size_t vtz_merged_lines_count(VtzMergedLinesHandle* lines_handle);
+// x, y pairs of all lines in world coordinates (origin top-left, y down)
+FFI_PLUGIN_EXPORT const double* vtz_merged_lines_coordinates(VtzMergedLinesHandle* lines_handle);
+// count + 1 point offsets; line i spans points [offsets[i], offsets[i + 1])
+FFI_PLUGIN_EXPORT const uint32_t* vtz_merged_lines_offsets(VtzMergedLinesHandle* lines_handle);
+// Number of clipped input pieces joined into line i
+FFI_PLUGIN_EXPORT uint32_t vtz_merged_lines_piece_count(VtzMergedLinesHandle* lines_handle, size_t index);
+// Merge key of line i (property value or id as text, empty for VTZ_MERGE_KEY_LAYER or unkeyed lines)
+FFI_PLUGIN_EXPORT const char* vtz_merged_lines_key(VtzMergedLinesHandle* lines_handle, size_t index);
+// World size in world units: largest extent * 2^max_zoom
+FFI_PLUGIN_EXPORT double vtz_merged_lines_world_size(VtzMergedLinesHandle* lines_handle);
+FFI_PLUGIN_EXPORT void vtz_merged_lines_free(VtzMergedLinesHandle* lines_handle);
+
+// Compact geometry store
+// Decodes the geometry of every feature of a tile once into zigzag-delta encoded tile
+// coordinates with part offsets. Deltas are stored in 16 bits per value where a feature's
+// deltas fit and 32 bits otherwise; each part restarts from absolute coordinates so parts
+// decode independently. The store copies what it needs and can outlive the tile handle.
+typedef struct VtzGeometryStoreHandle VtzGeometryStoreHandle;
+
+typedef struct {
+    const char* name;        // Owned by the store
+    uint32_t extent;
+    uint32_t first_feature;  // Store index of the layer's first feature
+    uint32_t feature_count;
+} VtzGeometryStoreLayer;
+
+typedef struct {
+    uint32_t geometry_type;  // 0=unknown, 1=point, 2=linestring, 3=polygon
+    uint32_t layer_index;
+    uint32_t part_count;     // 0 for features with invalid geometry
+    uint32_t point_count;
+} VtzGeometryStoreFeature;
+
+// Parts match vtz_feature_decode_geometry: all points of a (multi)point form one part, polygon
+// rings include the closing point. Features with invalid geometry are stored without parts.
+FFI_PLUGIN_EXPORT VtzGeometryStoreHandle* vtz_geometry_store_create(VtzTileHandle* tile_handle);
+// Builds the same store with thread_count worker threads (0 uses the hardware concurrency). The
+// tile's features are split into ranges balanced by size, so large layers are spread over
+// several workers; each worker encodes into its own buffers, which are joined in tile order.
+FFI_PLUGIN_EXPORT VtzGeometryStoreHandle* vtz_geometry_store_create_parallel(VtzTileHandle* tile_handle,
+                                                                             uint32_t thread_count);
+FFI_PLUGIN_EXPORT size_t vtz_geometry_store_layer_count(VtzGeometryStoreHandle* store_handle);
+FFI_PLUGIN_EXPORT VtzGeometryStoreLayer vtz_geometry_store_layer(VtzGeometryStoreHandle* store_handle,
+                                                                 size_t index);
+FFI_PLUGIN_EXPORT size_t vtz_geometry_store_feature_count(VtzGeometryStoreHandle* store_handle);
+FFI_PLUGIN_EXPORT VtzGeometryStoreFeature vtz_geometry_store_feature(VtzGeometryStoreHandle* store_handle,
+                                                                     size_t index);
+// Writes the first capacity of the feature's part_count + 1 point offsets to out and returns
+// part_count + 1
+FFI_PLUGIN_EXPORT size_t vtz_geometry_store_part_offsets(VtzGeometryStoreHandle* store_handle,
+                                                         size_t index,
+                                                         uint32_t* out,
+                                                         size_t capacity);
+// Writes x, y tile coordinates of the first capacity points of parts [part_begin, part_end) to
+// out (room for capacity pairs) and returns the point count of those parts
+FFI_PLUGIN_EXPORT size_t vtz_geometry_store_decode(VtzGeometryStoreHandle* store_handle,
+                                                   size_t index,
+                                                   uint32_t part_begin,
+                                                   uint32_t part_end,
+                                                   int32_t* out,
+                                                   size_t capacity);
+// Like vtz_geometry_store_decode, projected to lon, lat pairs (Web Mercator) for tile z/x/y
+FFI_PLUGIN_EXPORT size_t vtz_geometry_store_project(VtzGeometryStoreHandle* store_handle,
+                                                    size_t index,
+                                                    uint32_t part_begin,
+                                                    uint32_t part_end,
+                                                    uint32_t tile_z,
+                                                    uint32_t tile_x,
+                                                    uint32_t tile_y,
+                                                    double* out,
+                                                    size_t capacity);
+// Bytes held by the store
+FFI_PLUGIN_EXPORT size_t vtz_geometry_store_byte_size(VtzGeometryStoreHandle* store_handle);
+FFI_PLUGIN_EXPORT void vtz_geometry_store_free(VtzGeometryStoreHandle* store_handle);
+
+// Incremental decoding
+// A session decodes a tile into a geometry store a slice at a time, keeping its layer and
+// feature cursor between calls, so a large tile can be decoded across several frames. The
+// session reads the tile handle's buffer, so the tile handle must outlive the session.
+typedef struct VtzDecodeSessionHandle VtzDecodeSessionHandle;
+
+FFI_PLUGIN_EXPORT VtzDecodeSessionHandle* vtz_decode_session_create(VtzTileHandle* tile_handle);
+// Decodes features until budget_us microseconds have passed or max_features were decoded (0 for
+// no limit), and at least one feature. Returns the number of features added to the store by this
+// call. A malformed layer sets the exception and ends the session.
+FFI_PLUGIN_EXPORT size_t vtz_decode_session_step(VtzDecodeSessionHandle* session_handle,
+                                                 uint32_t budget_us,
+                                                 uint32_t max_features);
+FFI_PLUGIN_EXPORT bool vtz_decode_session_done(VtzDecodeSessionHandle* session_handle);
+// Store with everything decoded so far, owned by the session. Features are appended in tile
+// order and the last layer's feature_count grows until the session moves past it.
+FFI_PLUGIN_EXPORT VtzGeometryStoreHandle* vtz_decode_session_store(VtzDecodeSessionHandle* session_handle);
+FFI_PLUGIN_EXPORT void vtz_decode_session_free(VtzDecodeSessionHandle* session_handle);
+
 // Exception handling
 FFI_PLUGIN_EXPORT VtzExceptionType vtz_get_last_exception_type(void);
 FFI_PLUGIN_EXPORT const char* vtz_get_last_exception_message(void);
 FFI_PLUGIN_EXPORT void vtz_clear_exception(void);
 
+// Instrumentation
+// Compiled in only when the library is built with VTZ_ENABLE_STATS
+// (CMake option VTZERO_DART_ENABLE_STATS), otherwise all counters stay zero.
+
+// Call counter index for each exported function
+typedef enum {
+    VTZ_STATS_FN_TILE_CREATE = 0,
+    VTZ_STATS_FN_TILE_CREATE_COMPRESSED,
+    VTZ_STATS_FN_TILE_FREE,
+    VTZ_STATS_FN_TILE_NEXT_LAYER,
+    VTZ_STATS_FN_TILE_GET_LAYER_BY_NAME,
+    VTZ_STATS_FN_TILE_CACHE_CREATE,
+    VTZ_STATS_FN_TILE_CACHE_FREE,
+    VTZ_STATS_FN_TILE_CACHE_GET,
+    VTZ_STATS_FN_TILE_CACHE_PUT,
+    VTZ_STATS_FN_TILE_CACHE_REMOVE,
+    VTZ_STATS_FN_TILE_CACHE_CLEAR,
+    VTZ_STATS_FN_TILE_CACHE_STATS,
+    VTZ_STATS_FN_LAYER_FREE,
+    VTZ_STATS_FN_LAYER_NAME,
+    VTZ_STATS_FN_LAYER_EXTENT,
+    VTZ_STATS_FN_LAYER_VERSION,
+    VTZ_STATS_FN_LAYER_NEXT_FEATURE,
+    VTZ_STATS_FN_LAYER_VALUE_TABLE_SIZE,
+    VTZ_STATS_FN_LAYER_VALUE,
+    VTZ_STATS_FN_PROPERTY_VALUE_FREE,
+    VTZ_STATS_FN_PROPERTY_VALUE_TYPE,
+    VTZ_STATS_FN_PROPERTY_VALUE_STRING,
+    VTZ_STATS_FN_PROPERTY_VALUE_FLOAT,
+    VTZ_STATS_FN_PROPERTY_VALUE_DOUBLE,
+    VTZ_STATS_FN_PROPERTY_VALUE_INT,
+    VTZ_STATS_FN_PROPERTY_VALUE_UINT,
+    VTZ_STATS_FN_PROPERTY_VALUE_SINT,
+    VTZ_STATS_FN_PROPERTY_VALUE_BOOL,
+    VTZ_STATS_FN_FEATURE_FREE,
+    VTZ_STATS_FN_FEATURE_GEOMETRY_TYPE,
+    VTZ_STATS_FN_FEATURE_HAS_ID,
+    VTZ_STATS_FN_FEATURE_ID,
+    VTZ_STATS_FN_FEATURE_FOR_EACH_PROPERTY,
+    VTZ_STATS_FN_FEATURE_NEXT_PROPERTY_INDEXES,
+    VTZ_STATS_FN_FEATURE_RESET_PROPERTY,
+    VTZ_STATS_FN_FEATURE_FOR_EACH_PROPERTY_INDEXES,
+    VTZ_STATS_FN_FEATURE_DECODE_GEOMETRY,
+    VTZ_STATS_FN_FEATURE_TO_GEOJSON,
+    VTZ_STATS_FN_GET_LAST_EXCEPTION_TYPE,
+    VTZ_STATS_FN_GET_LAST_EXCEPTION_MESSAGE,
+    VTZ_STATS_FN_CLEAR_EXCEPTION,
+    VTZ_STATS_FN_FEATURE_LABEL_ANCHORS,
+    VTZ_STATS_FN_LAYER_LABEL_ANCHORS,
+    VTZ_STATS_FN_LABEL_ANCHORS_COUNT,
+    VTZ_STATS_FN_LABEL_ANCHORS_DATA,
+    VTZ_STATS_FN_LABEL_ANCHORS_FREE,
+    VTZ_STATS_FN_LAYER_BUILD_FEATURE_INDEX,
+    VTZ_STATS_FN_LAYER_GET_FEATURE_BY_ID,
+    VTZ_STATS_FN_LAYER_GET_FEATURES_BY_IDS,
+    VTZ_STATS_FN_MERGE_LINES,
+    VTZ_STATS_FN_MERGED_LINES_COUNT,
+    VTZ_STATS_FN_MERGED_LINES_COORDINATES,
+    VTZ_STATS_FN_MERGED_LINES_OFFSETS,
+    VTZ_STATS_FN_MERGED_LINES_PIECE_COUNT,
+    VTZ_STATS_FN_MERGED_LINES_KEY,
+    VTZ_STATS_FN_MERGED_LINES_WORLD_SIZE,
+    VTZ_STATS_FN_MERGED_LINES_FREE,
+    VTZ_STATS_FN_GEOMETRY_STORE_CREATE,
+    VTZ_STATS_FN_GEOMETRY_STORE_LAYER_COUNT,
+    VTZ_STATS_FN_GEOMETRY_STORE_LAYER,
+    VTZ_STATS_FN_GEOMETRY_STORE_FEATURE_COUNT,
+    VTZ_STATS_FN_GEOMETRY_STORE_FEATURE,
+    VTZ_STATS_FN_GEOMETRY_STORE_PART_OFFSETS,
+    VTZ_STATS_FN_GEOMETRY_STORE_DECODE,
+    VTZ_STATS_FN_GEOMETRY_STORE_PROJECT,
+    VTZ_STATS_FN_GEOMETRY_STORE_BYTE_SIZE,
+    VTZ_STATS_FN_GEOMETRY_STORE_FREE,
+    VTZ_STATS_FN_GEOMETRY_STORE_CREATE_PARALLEL,
+    VTZ_STATS_FN_DECODE_SESSION_CREATE,
+    VTZ_STATS_FN_DECODE_SESSION_STEP,
+    VTZ_STATS_FN_DECODE_SESSION_DONE,
+    VTZ_STATS_FN_DECODE_SESSION_STORE,
+    VTZ_STATS_FN_DECODE_SESSION_FREE,
+    VTZ_STATS_FN_FEATURE_DECODE_PROJECTED,
+    VTZ_STATS_FN_TILE_HASH,
+    VTZ_STATS_FN_LAYER_HASH,
+    VTZ_STATS_FN_LAYER_FEATURE_HASHES,
+    VTZ_STATS_FUNCTION_COUNT
+} VtzStatsFunction;
+
+// Heavy paths with latency histograms
+typedef enum {
+    VTZ_STATS_LATENCY_TILE_CREATE = 0,
+    VTZ_STATS_LATENCY_GEOMETRY_DECODE = 1,
+    VTZ_STATS_LATENCY_GEOJSON = 2,
+    VTZ_STATS_LATENCY_PROPERTY_ITERATION = 3,
+    VTZ_STATS_LATENCY_COUNT
+} VtzStatsLatency;
+
+// Bucket i counts calls that took [2^i, 2^(i+1)) nanoseconds
+#define VTZ_STATS_LATENCY_BUCKETS 40
+
+typedef struct {
+    bool enabled;
+    uint64_t calls[VTZ_STATS_FUNCTION_COUNT];
+    uint64_t latency_total_ns[VTZ_STATS_LATENCY_COUNT];
+    uint64_t latency_histogram[VTZ_STATS_LATENCY_COUNT][VTZ_STATS_LATENCY_BUCKETS];
+    uint64_t bytes_processed;   // Tile bytes passed to tile create functions
+    uint64_t vertices_emitted;  // Points produced by geometry decoding and GeoJSON conversion
+    int64_t live_tiles;
+    int64_t live_layers;
+    int64_t live_features;
+    int64_t live_property_values;
+} VtzStatsSnapshot;
+
+FFI_PLUGIN_EXPORT void vtz_stats_snapshot(VtzStatsSnapshot* out);
+// Resets call counters, histograms and totals; live handle counts are kept
+FFI_PLUGIN_EXPORT void vtz_stats_reset(void);
+
 #ifdef __cplusplus
 }
 #endif
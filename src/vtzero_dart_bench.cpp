@@ -0,0 +1,501 @@
+// Standalone benchmark for the vtzero_dart C API.
+//
+// Measures the native cost of every exported path without FFI, GC or JIT noise.
+// Tiles are loaded from test/fixtures/*/tile.mvt, test/data/chart.pbf and
+// performance_test/tiles (if present); no network access is needed.
+//
+// Usage: vtzero_dart_bench [--root <repo root>] [--iterations N] [--json <file>]
+
+#include "vtzero_dart.h"
+#include <zlib.h>
+#include <dirent.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef VTZERO_DART_SOURCE_DIR
+#define VTZERO_DART_SOURCE_DIR "."
+#endif
+
+// Allocation counting: the global operator new is replaced in this binary, so
+// only C++ allocations that bind to this replacement are counted. That covers
+// the library when the dynamic linker resolves its operator new calls to the
+// executable (the default on Linux); plain malloc calls, e.g. inside zlib, and
+// anything allocated on the Dart side of a real app are not counted.
+namespace {
+    std::atomic<uint64_t> g_allocations{0};
+}
+
+void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+    struct Tile {
+        std::string name;
+        std::string data;
+        std::string gzip_data;
+    };
+
+    struct Result {
+        std::string name;
+        std::vector<uint64_t> iteration_ns;  // Total time over all tiles, one per iteration
+        std::vector<uint64_t> tile_ns;       // Time for a single tile, one per tile and iteration
+        uint64_t allocations = 0;            // Summed over all iterations
+
+        static uint64_t percentile(std::vector<uint64_t> samples, double p) {
+            if (samples.empty()) return 0;
+            std::sort(samples.begin(), samples.end());
+            size_t index = static_cast<size_t>(p * static_cast<double>(samples.size()));
+            if (index >= samples.size()) index = samples.size() - 1;
+            return samples[index];
+        }
+
+        uint64_t iteration_median() const { return percentile(iteration_ns, 0.5); }
+        uint64_t tile_percentile(double p) const { return percentile(tile_ns, p); }
+
+        double allocations_per_iteration() const {
+            return iteration_ns.empty() ? 0.0 : static_cast<double>(allocations) / iteration_ns.size();
+        }
+    };
+
+    bool read_file(const std::string& path, std::string& out) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return false;
+        std::ostringstream buffer;
+        buffer << file.rdbuf();
+        out = buffer.str();
+        return true;
+    }
+
+    std::vector<std::string> list_dir(const std::string& path) {
+        std::vector<std::string> entries;
+        DIR* dir = opendir(path.c_str());
+        if (!dir) return entries;
+        while (dirent* entry = readdir(dir)) {
+            if (entry->d_name[0] != '.') {
+                entries.emplace_back(entry->d_name);
+            }
+        }
+        closedir(dir);
+        std::sort(entries.begin(), entries.end());
+        return entries;
+    }
+
+    bool ends_with(const std::string& str, const std::string& suffix) {
+        return str.size() >= suffix.size() &&
+               str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    std::string gzip(const std::string& data) {
+        z_stream stream;
+        std::memset(&stream, 0, sizeof(stream));
+        // 15 window bits, +16 to write a gzip header and trailer
+        deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+
+        std::string out(deflateBound(&stream, static_cast<uLong>(data.size())) + 32, '\0');
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+        stream.avail_in = static_cast<uInt>(data.size());
+        stream.next_out = reinterpret_cast<Bytef*>(&out[0]);
+        stream.avail_out = static_cast<uInt>(out.size());
+        deflate(&stream, Z_FINISH);
+        out.resize(stream.total_out);
+        deflateEnd(&stream);
+        return out;
+    }
+
+    void add_tile(std::vector<Tile>& tiles, const std::string& name, const std::string& path) {
+        Tile tile;
+        tile.name = name;
+        if (!read_file(path, tile.data)) return;
+
+        // Skip tiles that fail to parse, so every path measures the same set
+        VtzTileHandle* handle = vtz_tile_create(
+            reinterpret_cast<const uint8_t*>(tile.data.data()), tile.data.size());
+        bool valid = handle != nullptr;
+        while (valid) {
+            VtzLayerHandle* layer = vtz_tile_next_layer(handle);
+            if (vtz_get_last_exception_type() != VTZ_EXCEPTION_NONE) valid = false;
+            if (!layer) break;
+            while (VtzFeatureHandle* feature = vtz_layer_next_feature(layer)) {
+                vtz_feature_free(feature);
+            }
+            if (vtz_get_last_exception_type() != VTZ_EXCEPTION_NONE) valid = false;
+            vtz_layer_free(layer);
+        }
+        vtz_tile_free(handle);
+        vtz_clear_exception();
+
+        if (valid) {
+            tile.gzip_data = gzip(tile.data);
+            tiles.push_back(std::move(tile));
+        }
+    }
+
+    std::vector<Tile> load_tiles(const std::string& root) {
+        std::vector<Tile> tiles;
+
+        const std::string fixtures = root + "/test/fixtures";
+        for (const auto& dir : list_dir(fixtures)) {
+            add_tile(tiles, "fixtures/" + dir, fixtures + "/" + dir + "/tile.mvt");
+        }
+
+        add_tile(tiles, "data/chart.pbf", root + "/test/data/chart.pbf");
+
+        const std::string perf_tiles = root + "/performance_test/tiles";
+        for (const auto& file : list_dir(perf_tiles)) {
+            if (ends_with(file, ".mvt") || ends_with(file, ".pbf")) {
+                add_tile(tiles, "performance_test/" + file, perf_tiles + "/" + file);
+            }
+        }
+
+        return tiles;
+    }
+
+    // A decoded tile with all layer and feature handles, so individual
+    // feature paths can be timed without the iteration cost.
+    struct DecodedTile {
+        VtzTileHandle* tile = nullptr;
+        std::vector<VtzLayerHandle*> layers;
+        std::vector<std::pair<VtzFeatureHandle*, uint32_t>> features;  // Feature and its layer extent
+
+        explicit DecodedTile(const Tile& source) {
+            tile = vtz_tile_create(reinterpret_cast<const uint8_t*>(source.data.data()), source.data.size());
+            while (VtzLayerHandle* layer = vtz_tile_next_layer(tile)) {
+                layers.push_back(layer);
+                const uint32_t extent = vtz_layer_extent(layer);
+                while (VtzFeatureHandle* feature = vtz_layer_next_feature(layer)) {
+                    features.emplace_back(feature, extent);
+                }
+            }
+        }
+
+        ~DecodedTile() {
+            for (auto& feature : features) vtz_feature_free(feature.first);
+            for (auto* layer : layers) vtz_layer_free(layer);
+            vtz_tile_free(tile);
+        }
+    };
+
+    void noop_property(void*, const char*, int32_t, const char*, double, int64_t, uint64_t, bool) {}
+    void noop_geometry(void*, uint32_t, int32_t, int32_t) {}
+    void noop_geojson(void*, uint32_t, double, double) {}
+
+    using Clock = std::chrono::steady_clock;
+
+    uint64_t elapsed_ns(Clock::time_point start) {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    }
+
+    // Run a per-tile body for every tile and iteration. The body returns the
+    // time in nanoseconds spent in the measured section.
+    Result run(const char* name,
+               const std::vector<Tile>& tiles,
+               int iterations,
+               const std::function<uint64_t(const Tile&, uint64_t& allocations)>& body) {
+        Result result;
+        result.name = name;
+        result.iteration_ns.reserve(iterations);
+        result.tile_ns.reserve(static_cast<size_t>(iterations) * tiles.size());
+
+        for (int i = -3; i < iterations; ++i) {  // Three warmup iterations
+            uint64_t total_ns = 0;
+            uint64_t allocations = 0;
+            for (const auto& tile : tiles) {
+                const uint64_t tile_ns = body(tile, allocations);
+                total_ns += tile_ns;
+                if (i >= 0) result.tile_ns.push_back(tile_ns);
+            }
+            if (i >= 0) {
+                result.iteration_ns.push_back(total_ns);
+                result.allocations += allocations;
+            }
+        }
+
+        return result;
+    }
+
+    // Times a section and counts the allocations made in it
+    template <typename F>
+    uint64_t measure(uint64_t& allocations, F&& section) {
+        const uint64_t allocations_before = g_allocations.load(std::memory_order_relaxed);
+        const auto start = Clock::now();
+        section();
+        const uint64_t ns = elapsed_ns(start);
+        allocations += g_allocations.load(std::memory_order_relaxed) - allocations_before;
+        return ns;
+    }
+
+    std::vector<Result> run_all(const std::vector<Tile>& tiles, int iterations) {
+        std::vector<Result> results;
+
+        results.push_back(run("tile_create", tiles, iterations, [](const Tile& tile, uint64_t& allocs) {
+            VtzTileHandle* handle = nullptr;
+            const uint64_t ns = measure(allocs, [&] {
+                handle = vtz_tile_create(reinterpret_cast<const uint8_t*>(tile.data.data()), tile.data.size());
+            });
+            vtz_tile_free(handle);
+            return ns;
+        }));
+
+        results.push_back(run("tile_create_compressed", tiles, iterations, [](const Tile& tile, uint64_t& allocs) {
+            VtzTileHandle* handle = nullptr;
+            const uint64_t ns = measure(allocs, [&] {
+                handle = vtz_tile_create_compressed(
+                    reinterpret_cast<const uint8_t*>(tile.gzip_data.data()), tile.gzip_data.size());
+            });
+            vtz_tile_free(handle);
+            return ns;
+        }));
+
+        results.push_back(run("layer_iteration", tiles, iterations, [](const Tile& tile, uint64_t& allocs) {
+            VtzTileHandle* handle = vtz_tile_create(
+                reinterpret_cast<const uint8_t*>(tile.data.data()), tile.data.size());
+            const uint64_t ns = measure(allocs, [&] {
+                while (VtzLayerHandle* layer = vtz_tile_next_layer(handle)) {
+                    vtz_layer_free(layer);
+                }
+            });
+            vtz_tile_free(handle);
+            return ns;
+        }));
+
+        results.push_back(run("feature_iteration", tiles, iterations, [](const Tile& tile, uint64_t& allocs) {
+            VtzTileHandle* handle = vtz_tile_create(
+                reinterpret_cast<const uint8_t*>(tile.data.data()), tile.data.size());
+            std::vector<VtzLayerHandle*> layers;
+            while (VtzLayerHandle* layer = vtz_tile_next_layer(handle)) {
+                layers.push_back(layer);
+            }
+            const uint64_t ns = measure(allocs, [&] {
+                for (auto* layer : layers) {
+                    while (VtzFeatureHandle* feature = vtz_layer_next_feature(layer)) {
+                        vtz_feature_free(feature);
+                    }
+                }
+            });
+            for (auto* layer : layers) vtz_layer_free(layer);
+            vtz_tile_free(handle);
+            return ns;
+        }));
+
+        results.push_back(run("content_hash", tiles, iterations, [](const Tile& tile, uint64_t& allocs) {
+            VtzTileHandle* handle = vtz_tile_create(
+                reinterpret_cast<const uint8_t*>(tile.data.data()), tile.data.size());
+            std::vector<VtzLayerHandle*> layers;
+            while (VtzLayerHandle* layer = vtz_tile_next_layer(handle)) {
+                layers.push_back(layer);
+            }
+            std::vector<uint64_t> hashes(65536);
+            uint64_t sink = 0;
+            const uint64_t ns = measure(allocs, [&] {
+                for (auto* layer : layers) {
+                    sink ^= vtz_layer_hash(layer);
+                    vtz_layer_feature_hashes(layer, hashes.data(), hashes.size());
+                }
+            });
+            (void)sink;
+            for (auto* layer : layers) vtz_layer_free(layer);
+            vtz_tile_free(handle);
+            return ns;
+        }));
+
+        results.push_back(run("property_iteration", tiles, iterations, [](const Tile& tile, uint64_t& allocs) {
+            DecodedTile decoded(tile);
+            return measure(allocs, [&] {
+                for (auto& feature : decoded.features) {
+                    vtz_feature_for_each_property(feature.first, noop_property, nullptr);
+                }
+            });
+        }));
+
+        results.push_back(run("geometry_decode", tiles, iterations, [](const Tile& tile, uint64_t& allocs) {
+            DecodedTile decoded(tile);
+            return measure(allocs, [&] {
+                for (auto& feature : decoded.features) {
+                    vtz_feature_decode_geometry(feature.first, noop_geometry, nullptr);
+                }
+            });
+        }));
+
+        results.push_back(run("to_geojson", tiles, iterations, [](const Tile& tile, uint64_t& allocs) {
+            DecodedTile decoded(tile);
+            return measure(allocs, [&] {
+                for (auto& feature : decoded.features) {
+                    vtz_feature_to_geojson(feature.first, feature.second, 0, 0, 0, noop_geojson, nullptr);
+                }
+            });
+        }));
+
+        results.push_back(run("decode_projected", tiles, iterations, [](const Tile& tile, uint64_t& allocs) {
+            DecodedTile decoded(tile);
+            std::vector<double> coordinates(2 * 65536);
+            std::vector<uint32_t> part_offsets(4096);
+            VtzProjectionParams params{};
+            return measure(allocs, [&] {
+                for (auto& feature : decoded.features) {
+                    params.extent = feature.second;
+                    VtzProjectedGeometry out{coordinates.data(), coordinates.size() / 2,
+                                             part_offsets.data(), part_offsets.size(), 0, 0};
+                    vtz_feature_decode_projected(feature.first, VTZ_PROJECTION_WGS84, &params, &out);
+                }
+            });
+        }));
+
+        results.push_back(run("geometry_store", tiles, iterations, [](const Tile& tile, uint64_t& allocs) {
+            VtzTileHandle* handle = vtz_tile_create(
+                reinterpret_cast<const uint8_t*>(tile.data.data()), tile.data.size());
+            VtzGeometryStoreHandle* store = nullptr;
+            const uint64_t ns = measure(allocs, [&] { store = vtz_geometry_store_create(handle); });
+            vtz_geometry_store_free(store);
+            vtz_tile_free(handle);
+            return ns;
+        }));
+
+        results.push_back(run("geometry_store_parallel", tiles, iterations, [](const Tile& tile, uint64_t& allocs) {
+            VtzTileHandle* handle = vtz_tile_create(
+                reinterpret_cast<const uint8_t*>(tile.data.data()), tile.data.size());
+            VtzGeometryStoreHandle* store = nullptr;
+            const uint64_t ns = measure(allocs, [&] { store = vtz_geometry_store_create_parallel(handle, 0); });
+            vtz_geometry_store_free(store);
+            vtz_tile_free(handle);
+            return ns;
+        }));
+
+        vtz_clear_exception();
+        return results;
+    }
+
+    std::string json_escape(const std::string& str) {
+        std::string out;
+        for (char c : str) {
+            if (c == '"' || c == '\\') out += '\\';
+            out += c;
+        }
+        return out;
+    }
+
+    void write_json(const std::string& path,
+                    const std::vector<Tile>& tiles,
+                    uint64_t features,
+                    uint64_t bytes,
+                    int iterations,
+                    const std::vector<Result>& results) {
+        std::ofstream out(path);
+        out << "{\n";
+        out << "  \"tiles\": " << tiles.size() << ",\n";
+        out << "  \"features\": " << features << ",\n";
+        out << "  \"bytes\": " << bytes << ",\n";
+        out << "  \"iterations\": " << iterations << ",\n";
+        out << "  \"results\": [\n";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const auto& result = results[i];
+            const uint64_t median = result.iteration_median();
+            out << "    {\"name\": \"" << json_escape(result.name) << "\""
+                << ", \"iteration_median_ns\": " << median
+                << ", \"tile_p50_ns\": " << result.tile_percentile(0.5)
+                << ", \"tile_p99_ns\": " << result.tile_percentile(0.99)
+                << ", \"ns_per_feature\": " << (features ? static_cast<double>(median) / features : 0.0)
+                << ", \"mb_per_s\": " << (median ? bytes * 1000.0 / median : 0.0)
+                << ", \"allocations_per_iteration\": " << result.allocations_per_iteration()
+                << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n";
+        out << "}\n";
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string root = VTZERO_DART_SOURCE_DIR;
+    std::string json_path;
+    int iterations = 100;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--root" && i + 1 < argc) {
+            root = argv[++i];
+        } else if (arg == "--iterations" && i + 1 < argc) {
+            iterations = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--json" && i + 1 < argc) {
+            json_path = argv[++i];
+        } else {
+            std::fprintf(stderr, "Usage: %s [--root <repo root>] [--iterations N] [--json <file>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    const auto tiles = load_tiles(root);
+    if (tiles.empty()) {
+        std::fprintf(stderr, "No tiles found under %s\n", root.c_str());
+        return 1;
+    }
+
+    uint64_t features = 0;
+    uint64_t bytes = 0;
+    for (const auto& tile : tiles) {
+        DecodedTile decoded(tile);
+        features += decoded.features.size();
+        bytes += tile.data.size();
+    }
+
+    std::printf("Loaded %zu tiles, %llu features, %llu bytes; %d iterations\n\n",
+                tiles.size(), static_cast<unsigned long long>(features),
+                static_cast<unsigned long long>(bytes), iterations);
+
+    const auto results = run_all(tiles, iterations);
+
+    std::printf("%-24s %12s %12s %12s %12s %10s %12s\n",
+                "path", "iter(us)", "tile p50(us)", "tile p99(us)", "ns/feature", "MB/s", "allocs/iter");
+    for (const auto& result : results) {
+        const uint64_t median = result.iteration_median();
+        std::printf("%-24s %12.1f %12.2f %12.2f %12.1f %10.1f %12.1f\n",
+                    result.name.c_str(),
+                    median / 1000.0,
+                    result.tile_percentile(0.5) / 1000.0,
+                    result.tile_percentile(0.99) / 1000.0,
+                    features ? static_cast<double>(median) / features : 0.0,
+                    median ? bytes * 1000.0 / median : 0.0,
+                    result.allocations_per_iteration());
+    }
+
+    if (!json_path.empty()) {
+        write_json(json_path, tiles, features, bytes, iterations, results);
+        std::printf("\nWrote %s\n", json_path.c_str());
+    }
+
+    return 0;
+}
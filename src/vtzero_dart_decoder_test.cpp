@@ -0,0 +1,414 @@
+// Differential test of the wrapper's geometry command decoder against vtzero.
+//
+// Every geometry is decoded with GeometryCommandDecoder and with
+// vtzero::decode_point/linestring/polygon_geometry, and the handler calls and
+// any exception (type and message) must be identical. Inputs are the features
+// of test/fixtures/*/tile.mvt and test/data/chart.pbf (each decoded as point,
+// linestring and polygon), hand-written command streams for the edge cases,
+// and deterministic mutations of the fixture geometries. The C API is checked
+// too: vtz_feature_decode_geometry must return the same code, exception and
+// callbacks as the vtzero-based implementation it replaced.
+//
+// Usage: vtzero_dart_decoder_test [--root <repo root>]
+
+// The decoder is internal to the wrapper, so compile it into this test
+#include "vtzero_wrapper.cpp"
+
+#include <dirent.h>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef VTZERO_DART_SOURCE_DIR
+#define VTZERO_DART_SOURCE_DIR "."
+#endif
+
+namespace {
+    int g_checks = 0;
+    int g_failures = 0;
+
+    // Records handler calls as text, so mismatches can be printed
+    struct RecordingHandler {
+        std::vector<std::string> calls;
+
+        void add(const char* name, int64_t a = 0, int64_t b = 0) {
+            calls.push_back(std::string(name) + " " + std::to_string(a) + " " + std::to_string(b));
+        }
+
+        void points_begin(uint32_t count) { add("points_begin", count); }
+        void points_point(const vtzero::point p) { add("points_point", p.x, p.y); }
+        void points_end() { add("points_end"); }
+        void linestring_begin(uint32_t count) { add("linestring_begin", count); }
+        void linestring_point(const vtzero::point p) { add("linestring_point", p.x, p.y); }
+        void linestring_end() { add("linestring_end"); }
+        void ring_begin(uint32_t count) { add("ring_begin", count); }
+        void ring_point(const vtzero::point p) { add("ring_point", p.x, p.y); }
+        void ring_end(vtzero::ring_type type) { add("ring_end", static_cast<int64_t>(type)); }
+    };
+
+    struct Outcome {
+        std::vector<std::string> calls;
+        std::string error;  // Exception type and message, empty on success
+    };
+
+    template <typename F>
+    Outcome run(F&& decode) {
+        RecordingHandler handler;
+        Outcome outcome;
+        try {
+            decode(handler);
+        } catch (const vtzero::geometry_exception& e) {
+            outcome.error = std::string("geometry_exception: ") + e.what();
+        } catch (const protozero::exception& e) {
+            outcome.error = std::string("protozero::exception: ") + e.what();
+        } catch (const std::exception& e) {
+            outcome.error = std::string("std::exception: ") + e.what();
+        }
+        outcome.calls = std::move(handler.calls);
+        return outcome;
+    }
+
+    void report(const std::string& label, const Outcome& expected, const Outcome& actual) {
+        ++g_failures;
+        std::fprintf(stderr, "FAIL %s\n  vtzero:  %zu calls, %s\n  decoder: %zu calls, %s\n",
+                     label.c_str(), expected.calls.size(), expected.error.c_str(),
+                     actual.calls.size(), actual.error.c_str());
+        for (size_t i = 0; i < std::min(expected.calls.size(), actual.calls.size()); ++i) {
+            if (expected.calls[i] != actual.calls[i]) {
+                std::fprintf(stderr, "  call %zu: %s vs %s\n", i, expected.calls[i].c_str(),
+                             actual.calls[i].c_str());
+                break;
+            }
+        }
+    }
+
+    // Decodes the geometry as the given type with both decoders and compares them
+    Outcome compare(const std::string& label, const vtzero::geometry& geometry, vtzero::GeomType type) {
+        Outcome expected;
+        Outcome actual;
+        switch (type) {
+            case vtzero::GeomType::POINT:
+                expected = run([&](RecordingHandler& h) { vtzero::decode_point_geometry(geometry, h); });
+                actual = run([&](RecordingHandler& h) { GeometryCommandDecoder{geometry}.decode_point(h); });
+                break;
+            case vtzero::GeomType::LINESTRING:
+                expected = run([&](RecordingHandler& h) { vtzero::decode_linestring_geometry(geometry, h); });
+                actual = run([&](RecordingHandler& h) { GeometryCommandDecoder{geometry}.decode_linestring(h); });
+                break;
+            default:
+                expected = run([&](RecordingHandler& h) { vtzero::decode_polygon_geometry(geometry, h); });
+                actual = run([&](RecordingHandler& h) { GeometryCommandDecoder{geometry}.decode_polygon(h); });
+                break;
+        }
+
+        ++g_checks;
+        if (expected.calls != actual.calls || expected.error != actual.error) {
+            report(label, expected, actual);
+        }
+        return actual;
+    }
+
+    void compare_all_types(const std::string& label, const vtzero::geometry& geometry) {
+        compare(label + " as point", geometry, vtzero::GeomType::POINT);
+        compare(label + " as linestring", geometry, vtzero::GeomType::LINESTRING);
+        compare(label + " as polygon", geometry, vtzero::GeomType::POLYGON);
+    }
+
+    std::string encode(const std::vector<uint32_t>& values) {
+        std::string out;
+        for (uint32_t value : values) {
+            while (value >= 0x80) {
+                out += static_cast<char>((value & 0x7f) | 0x80);
+                value >>= 7;
+            }
+            out += static_cast<char>(value);
+        }
+        return out;
+    }
+
+    constexpr uint32_t command(uint32_t id, uint32_t count) { return (count << 3) | id; }
+    constexpr uint32_t zigzag(int32_t value) {
+        return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+    }
+
+    struct Case {
+        const char* name;
+        vtzero::GeomType type;
+        std::string data;
+        bool throws;
+        const char* expect_call;  // Must appear in the handler calls, or nullptr
+    };
+
+    // Edge cases the fixtures do not necessarily contain
+    std::vector<Case> edge_cases() {
+        const uint32_t M1 = command(1, 1);
+        const uint32_t CP = command(7, 1);
+        const auto P = vtzero::GeomType::POINT;
+        const auto L = vtzero::GeomType::LINESTRING;
+        const auto A = vtzero::GeomType::POLYGON;
+
+        return {
+            // Ring orientation by signed area, y pointing down
+            {"clockwise ring is outer", A,
+             encode({M1, 0, 0, command(2, 3), zigzag(10), 0, 0, zigzag(10), zigzag(-10), 0, CP}),
+             false, "ring_end 0 0"},
+            {"counter-clockwise ring is inner", A,
+             encode({M1, 0, 0, command(2, 3), 0, zigzag(10), zigzag(10), 0, 0, zigzag(-10), CP}),
+             false, "ring_end 1 0"},
+            {"zero area ring is invalid", A,
+             encode({M1, 0, 0, command(2, 2), zigzag(10), 0, zigzag(-10), 0, CP}),
+             false, "ring_end 2 0"},
+            {"outer ring with hole", A,
+             encode({M1, 0, 0, command(2, 3), zigzag(10), 0, 0, zigzag(10), zigzag(-10), 0, CP,
+                     M1, zigzag(2), zigzag(-8), command(2, 3), 0, zigzag(5), zigzag(5), 0, 0, zigzag(-5), CP}),
+             false, "ring_end 1 0"},
+            {"large coordinate ring orientation", A,
+             encode({M1, zigzag(-(1 << 29)), zigzag(-(1 << 29)), command(2, 3), zigzag(1 << 30), 0, 0,
+                     zigzag(1 << 30), zigzag(-(1 << 30)), 0, CP}),
+             false, "ring_end 0 0"},
+
+            // Zero-length commands
+            {"empty point geometry", P, "", true, nullptr},
+            {"empty linestring geometry", L, "", false, nullptr},
+            {"empty polygon geometry", A, "", false, nullptr},
+            {"point MoveTo count zero", P, encode({command(1, 0)}), true, nullptr},
+            {"linestring MoveTo count zero", L, encode({command(1, 0), command(2, 1), 2, 2}), true, nullptr},
+            {"linestring LineTo count zero", L, encode({M1, 0, 0, command(2, 0)}), true, nullptr},
+            {"polygon MoveTo count zero", A, encode({command(1, 0), command(2, 1), 2, 2, CP}), true, nullptr},
+            {"polygon LineTo count zero", A, encode({M1, 0, 0, command(2, 0), CP}), false, "ring_begin 2 0"},
+            {"multipoint", P, encode({command(1, 3), 2, 2, 4, 4, 6, 6}), false, "points_begin 3 0"},
+
+            // ClosePath errors
+            {"ClosePath count zero", A, encode({M1, 0, 0, command(2, 2), 2, 0, 0, 2, command(7, 0)}), true, nullptr},
+            {"ClosePath count two", A, encode({M1, 0, 0, command(2, 2), 2, 0, 0, 2, command(7, 2)}), true, nullptr},
+            {"missing ClosePath", A, encode({M1, 0, 0, command(2, 2), 2, 0, 0, 2}), true, nullptr},
+            {"LineTo instead of ClosePath", A, encode({M1, 0, 0, command(2, 2), 2, 0, 0, 2, command(2, 1), 2, 2}),
+             true, nullptr},
+            {"ClosePath in linestring", L, encode({M1, 0, 0, command(2, 1), 2, 2, CP}), true, nullptr},
+            {"ClosePath in point", P, encode({M1, 2, 2, CP}), true, nullptr},
+            {"ClosePath first", A, encode({CP}), true, nullptr},
+            {"unknown command id", A, encode({command(3, 1), 2, 2}), true, nullptr},
+
+            // Counts and coordinates out of range
+            {"count larger than the data", L, encode({M1, 0, 0, command(2, 1000), 2, 2}), true, nullptr},
+            {"maximum command count", P, encode({command(1, 0x1fffffff), 2, 2}), true, nullptr},
+            {"missing y parameter", P, encode({command(1, 2), 2, 2, 4}), true, nullptr},
+            {"trailing data after points", P, encode({M1, 2, 2, M1}), true, nullptr},
+            {"x overflows int32", P,
+             encode({command(1, 2), zigzag(0x7fffffff), 0, zigzag(0x7fffffff), 0}),
+             false, "points_point -2 0"},
+            {"y underflows int32", L,
+             encode({M1, 0, zigzag(-0x7fffffff - 1), command(2, 1), 0, zigzag(-1)}),
+             false, "linestring_point 0 2147483647"},
+            {"parameter wider than 32 bits", P,
+             encode({M1}) + std::string("\xff\xff\xff\xff\x7f", 5) + encode({2}), false, nullptr},
+            {"truncated varint", P, encode({M1, 2}) + std::string("\x80", 1), true, nullptr},
+            {"overlong varint", P, encode({M1}) + std::string(11, '\xff') + encode({2}), true, nullptr},
+        };
+    }
+
+    void check_edge_cases() {
+        for (const auto& c : edge_cases()) {
+            const vtzero::geometry geometry{vtzero::data_view{c.data.data(), c.data.size()}, c.type};
+            const auto outcome = compare(std::string("edge case '") + c.name + "'", geometry, c.type);
+
+            // Make sure each case exercises the path it is named after
+            ++g_checks;
+            if (outcome.error.empty() == c.throws) {
+                ++g_failures;
+                std::fprintf(stderr, "FAIL edge case '%s' %s\n", c.name,
+                             c.throws ? "did not throw" : ("threw " + outcome.error).c_str());
+            }
+            if (c.expect_call && std::find(outcome.calls.begin(), outcome.calls.end(), c.expect_call) ==
+                                     outcome.calls.end()) {
+                ++g_failures;
+                std::fprintf(stderr, "FAIL edge case '%s' has no call '%s'\n", c.name, c.expect_call);
+            }
+        }
+    }
+
+    // The vtzero-based vtz_feature_decode_geometry this wrapper used before its own decoder
+    void reference_decode_geometry(const vtzero::geometry& geometry, GeometryHandler& handler) {
+        switch (geometry.type()) {
+            case vtzero::GeomType::POINT:
+                vtzero::decode_point_geometry(geometry, handler);
+                break;
+            case vtzero::GeomType::LINESTRING:
+                vtzero::decode_linestring_geometry(geometry, handler);
+                break;
+            case vtzero::GeomType::POLYGON:
+                vtzero::decode_polygon_geometry(geometry, handler);
+                break;
+            default:
+                throw vtzero::geometry_exception{"unknown geometry type"};
+        }
+    }
+
+    void record_callback(void* user_data, uint32_t command, int32_t x, int32_t y) {
+        static_cast<std::vector<std::string>*>(user_data)->push_back(
+            std::to_string(command) + " " + std::to_string(x) + " " + std::to_string(y));
+    }
+
+    struct ApiOutcome {
+        int result = 0;
+        int exception_type = VTZ_EXCEPTION_NONE;
+        std::string message;
+        std::vector<std::string> callbacks;
+
+        bool operator==(const ApiOutcome& other) const {
+            return result == other.result && exception_type == other.exception_type &&
+                   message == other.message && callbacks == other.callbacks;
+        }
+    };
+
+    // Compares vtz_feature_decode_geometry with the vtzero-based implementation
+    void check_api(const std::string& label, VtzFeatureHandle* feature) {
+        ApiOutcome expected;
+        {
+            GeometryHandler handler{record_callback, &expected.callbacks};
+            try {
+                reference_decode_geometry(feature->feature.geometry(), handler);
+            } catch (const vtzero::geometry_exception& e) {
+                expected.result = 1;
+                expected.exception_type = VTZ_EXCEPTION_GEOMETRY;
+                expected.message = e.what();
+            } catch (const std::exception& e) {
+                expected.result = -1;
+                expected.exception_type = VTZ_EXCEPTION_GEOMETRY;
+                expected.message = e.what();
+            }
+        }
+
+        ApiOutcome actual;
+        actual.result = vtz_feature_decode_geometry(feature, record_callback, &actual.callbacks);
+        actual.exception_type = vtz_get_last_exception_type();
+        const char* message = vtz_get_last_exception_message();
+        actual.message = message ? message : "";
+
+        ++g_checks;
+        if (!(expected == actual)) {
+            ++g_failures;
+            std::fprintf(stderr, "FAIL %s vtz_feature_decode_geometry\n  vtzero:  %d %d '%s' %zu callbacks\n"
+                         "  decoder: %d %d '%s' %zu callbacks\n",
+                         label.c_str(), expected.result, expected.exception_type, expected.message.c_str(),
+                         expected.callbacks.size(), actual.result, actual.exception_type,
+                         actual.message.c_str(), actual.callbacks.size());
+        }
+    }
+
+    // Random byte edits of a geometry; the same seed gives the same mutations on every run
+    void check_mutations(const std::string& label, const vtzero::geometry& geometry, std::mt19937& rng) {
+        const std::string original(geometry.data().data(), geometry.data().size());
+        if (original.empty() || original.size() > 4096) return;
+
+        for (int i = 0; i < 8; ++i) {
+            std::string data = original;
+            const size_t position = rng() % data.size();
+            switch (rng() % 4) {
+                case 0:  // Change a byte
+                    data[position] = static_cast<char>(rng());
+                    break;
+                case 1:  // Truncate
+                    data.resize(position);
+                    break;
+                case 2:  // Insert a command
+                    data.insert(position, encode({command(rng() % 8, rng() % 4)}));
+                    break;
+                default:  // Remove a byte
+                    data.erase(position, 1);
+                    break;
+            }
+            compare_all_types(label + " mutation " + std::to_string(i),
+                              vtzero::geometry{vtzero::data_view{data.data(), data.size()}, geometry.type()});
+        }
+    }
+
+    bool read_file(const std::string& path, std::string& out) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return false;
+        std::ostringstream buffer;
+        buffer << file.rdbuf();
+        out = buffer.str();
+        return true;
+    }
+
+    std::vector<std::string> list_dir(const std::string& path) {
+        std::vector<std::string> entries;
+        DIR* dir = opendir(path.c_str());
+        if (!dir) return entries;
+        while (dirent* entry = readdir(dir)) {
+            if (entry->d_name[0] != '.') {
+                entries.emplace_back(entry->d_name);
+            }
+        }
+        closedir(dir);
+        std::sort(entries.begin(), entries.end());
+        return entries;
+    }
+
+    // Compares every feature of a tile; returns the number of features
+    size_t check_tile(const std::string& name, const std::string& data, std::mt19937& rng) {
+        size_t features = 0;
+
+        VtzTileHandle* tile = vtz_tile_create(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+        if (!tile) return 0;
+
+        // Malformed layers and features end iteration, as they do in the API
+        while (VtzLayerHandle* layer = vtz_tile_next_layer(tile)) {
+            while (VtzFeatureHandle* feature = vtz_layer_next_feature(layer)) {
+                const std::string label = name + " feature " + std::to_string(features++);
+                const auto geometry = feature->feature.geometry();
+                compare_all_types(label, geometry);
+                check_api(label, feature);
+                check_mutations(label, geometry, rng);
+                vtz_feature_free(feature);
+            }
+            vtz_layer_free(layer);
+        }
+        vtz_tile_free(tile);
+        return features;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string root = VTZERO_DART_SOURCE_DIR;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--root" && i + 1 < argc) {
+            root = argv[++i];
+        } else {
+            std::fprintf(stderr, "Usage: %s [--root <repo root>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    std::mt19937 rng(20251018);
+    size_t tiles = 0;
+    size_t features = 0;
+    std::string data;
+
+    const std::string fixtures = root + "/test/fixtures";
+    for (const auto& entry : list_dir(fixtures)) {
+        if (read_file(fixtures + "/" + entry + "/tile.mvt", data)) {
+            features += check_tile(entry, data, rng);
+            ++tiles;
+        }
+    }
+    if (read_file(root + "/test/data/chart.pbf", data)) {
+        features += check_tile("chart.pbf", data, rng);
+        ++tiles;
+    }
+    if (tiles == 0) {
+        std::fprintf(stderr, "No tiles found under %s\n", root.c_str());
+        return 1;
+    }
+
+    check_edge_cases();
+
+    std::printf("%zu tiles, %zu features, %d checks, %d failures\n", tiles, features, g_checks, g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
@@ -5,8 +5,18 @@
 #include <string>
 #include <vector>
 #include <cstring>
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <mutex>
+#include <limits>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <zlib.h>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -33,35 +43,462 @@ namespace {
         g_exception_storage.type = VTZ_EXCEPTION_NONE;
         g_exception_storage.message.clear();
     }
+
+    // Compressed tile support
+    enum class TileCompression {
+        none,
+        gzip,
+        zlib
+    };
+
+    TileCompression detect_compression(const uint8_t* data, size_t length) {
+        // gzip: magic bytes 1f 8b, 10 byte header and 8 byte trailer
+        if (length >= 18 && data[0] == 0x1f && data[1] == 0x8b) {
+            return TileCompression::gzip;
+        }
+        // zlib: deflate method with a valid window size and header checksum
+        // An uncompressed tile starts with the layers tag (0x1a), so this can't collide
+        if (length >= 6 && (data[0] & 0x0f) == 8 && (data[0] >> 4) <= 7 &&
+            ((static_cast<uint32_t>(data[0]) << 8) | data[1]) % 31 == 0) {
+            return TileCompression::zlib;
+        }
+        return TileCompression::none;
+    }
+
+    // Initial output buffer size for inflating a compressed tile.
+    // gzip stores the uncompressed size (mod 2^32) in the ISIZE trailer,
+    // which lets us inflate with a single allocation in the common case.
+    // The trailer is untrusted, so it is clamped to the maximum deflate ratio.
+    size_t inflate_size_hint(const uint8_t* data, size_t length, TileCompression compression) {
+        const size_t max_ratio = 1032;
+        const size_t max_size = length > std::numeric_limits<size_t>::max() / max_ratio
+            ? std::numeric_limits<size_t>::max()
+            : length * max_ratio;
+
+        if (compression == TileCompression::gzip) {
+            const uint8_t* trailer = data + length - 4;
+            const size_t isize = static_cast<size_t>(trailer[0]) |
+                                 (static_cast<size_t>(trailer[1]) << 8) |
+                                 (static_cast<size_t>(trailer[2]) << 16) |
+                                 (static_cast<size_t>(trailer[3]) << 24);
+            if (isize > 0 && isize <= max_size) {
+                return isize;
+            }
+        }
+        return std::min(length * 4, max_size);
+    }
+
+    // Inflate gzip or zlib data into a buffer sized from the gzip trailer.
+    // Concatenated gzip members are inflated back to back.
+    // Throws vtzero::format_exception on malformed input.
+    std::string inflate_tile(const uint8_t* data, size_t length, TileCompression compression) {
+        std::string out;
+        out.resize(inflate_size_hint(data, length, compression));
+
+        z_stream stream;
+        std::memset(&stream, 0, sizeof(stream));
+        // 15 window bits, +32 to detect the gzip or zlib header automatically
+        if (inflateInit2(&stream, 15 + 32) != Z_OK) {
+            throw vtzero::format_exception{"failed to initialize zlib"};
+        }
+
+        const uInt max_chunk = std::numeric_limits<uInt>::max();
+        const uint8_t* in = data;
+        size_t in_left = length;
+        size_t written = 0;
+        int ret = Z_OK;
+
+        while (true) {
+            if (written == out.size()) {
+                out.resize(out.size() * 2);
+            }
+
+            stream.next_in = const_cast<Bytef*>(in);
+            stream.avail_in = static_cast<uInt>(std::min<size_t>(in_left, max_chunk));
+            stream.next_out = reinterpret_cast<Bytef*>(&out[written]);
+            stream.avail_out = static_cast<uInt>(std::min<size_t>(out.size() - written, max_chunk));
+
+            const uInt avail_in = stream.avail_in;
+            const uInt avail_out = stream.avail_out;
+            ret = inflate(&stream, Z_NO_FLUSH);
+            in += avail_in - stream.avail_in;
+            in_left -= avail_in - stream.avail_in;
+            written += avail_out - stream.avail_out;
+
+            if (ret == Z_STREAM_END) {
+                // Skip zero padding some servers append after the gzip trailer
+                while (in_left > 0 && *in == 0) {
+                    ++in;
+                    --in_left;
+                }
+                if (in_left == 0 || compression != TileCompression::gzip) {
+                    break;
+                }
+                ret = inflateReset(&stream);
+            } else if (ret == Z_BUF_ERROR && in_left == 0) {
+                break;
+            }
+
+            if (ret != Z_OK && ret != Z_BUF_ERROR) {
+                break;
+            }
+        }
+
+        inflateEnd(&stream);
+
+        if (ret != Z_STREAM_END) {
+            throw vtzero::format_exception{
+                std::string{"invalid compressed tile data: "} + (stream.msg ? stream.msg : "truncated stream")};
+        }
+
+        out.resize(written);
+        return out;
+    }
+}
+
+// Optional instrumentation, compiled in with VTZ_ENABLE_STATS.
+// All counters are relaxed atomics; when disabled the macros expand to nothing.
+#ifdef VTZ_ENABLE_STATS
+namespace {
+    struct Stats {
+        std::atomic<uint64_t> calls[VTZ_STATS_FUNCTION_COUNT];
+        std::atomic<uint64_t> latency_total_ns[VTZ_STATS_LATENCY_COUNT];
+        std::atomic<uint64_t> latency_histogram[VTZ_STATS_LATENCY_COUNT][VTZ_STATS_LATENCY_BUCKETS];
+        std::atomic<uint64_t> bytes_processed;
+        std::atomic<uint64_t> vertices_emitted;
+        std::atomic<int64_t> live_tiles;
+        std::atomic<int64_t> live_layers;
+        std::atomic<int64_t> live_features;
+        std::atomic<int64_t> live_property_values;
+    };
+
+    // Static storage, so all counters start zeroed
+    static Stats g_stats;
+
+    // Index of the highest set bit, i.e. floor(log2(value)) for value > 0
+    inline uint32_t log2_bucket(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+        const uint32_t bucket = value ? 63 - static_cast<uint32_t>(__builtin_clzll(value)) : 0;
+#else
+        uint32_t bucket = 0;
+        while (value >>= 1) ++bucket;
+#endif
+        return bucket < VTZ_STATS_LATENCY_BUCKETS ? bucket : VTZ_STATS_LATENCY_BUCKETS - 1;
+    }
+
+    // Records the lifetime of the enclosing scope into a latency histogram
+    class LatencyTimer {
+        VtzStatsLatency kind_;
+        std::chrono::steady_clock::time_point start_;
+
+    public:
+        explicit LatencyTimer(VtzStatsLatency kind)
+            : kind_(kind), start_(std::chrono::steady_clock::now()) {}
+
+        ~LatencyTimer() {
+            const auto elapsed = std::chrono::steady_clock::now() - start_;
+            const auto ns = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            g_stats.latency_total_ns[kind_].fetch_add(ns, std::memory_order_relaxed);
+            g_stats.latency_histogram[kind_][log2_bucket(ns)].fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+}
+
+#define VTZ_STATS_CALL(fn) g_stats.calls[fn].fetch_add(1, std::memory_order_relaxed)
+#define VTZ_STATS_TIME(kind) LatencyTimer vtz_stats_timer_(kind)
+#define VTZ_STATS_ADD(counter, n) g_stats.counter.fetch_add((n), std::memory_order_relaxed)
+#else
+#define VTZ_STATS_CALL(fn) ((void)0)
+#define VTZ_STATS_TIME(kind) ((void)0)
+#define VTZ_STATS_ADD(counter, n) ((void)(n))
+#endif
+
+// Tile data held by a VtzTileCacheHandle and shared by the tile handles served from it.
+// An entry is pinned while any tile handle references it and is never evicted then.
+struct TileCacheEntry {
+    std::string data;
+    std::atomic<uint32_t> pins{0};
+
+    explicit TileCacheEntry(std::string&& bytes) : data(std::move(bytes)) {}
+};
+
+namespace {
+    // Visit every feature of a layer without moving the layer's own feature cursor
+    template <typename F>
+    void for_each_layer_feature(const vtzero::layer& layer, F&& func) {
+        protozero::pbf_message<vtzero::detail::pbf_layer> reader{layer.data()};
+        while (reader.next(vtzero::detail::pbf_layer::features)) {
+            func(vtzero::feature{&layer, reader.get_view()});
+        }
+    }
+
+    // Feature id -> feature message within the layer. Duplicate ids keep the
+    // first feature, like vtzero::layer::get_feature_by_id.
+    using FeatureIdIndex = std::unordered_map<uint64_t, vtzero::data_view>;
+}
+
+// Geometry command decoding
+// Decodes the MVT command stream (spec 4.3) with the same handler calls, results and exceptions
+// as vtzero::decode_*_geometry. Varints are read straight from the geometry buffer and each
+// MoveTo/LineTo run is decoded in one loop, with a fast path for the common case of one byte
+// parameters and branchless zigzag decoding, instead of vtzero's per value varint iterator.
+namespace {
+    class GeometryCommandDecoder {
+    public:
+        explicit GeometryCommandDecoder(const vtzero::geometry& geometry)
+            : m_it(geometry.data().data()),
+              m_end(geometry.data().data() + geometry.data().size()),
+              m_max_count(static_cast<uint32_t>(geometry.data().size() / 2)) {}
+
+        template <typename Handler>
+        void decode_point(Handler& handler) {
+            // spec 4.3.4.2 "MUST consist of a single MoveTo command"
+            if (!next_command(MOVE_TO)) {
+                throw vtzero::geometry_exception{"expected MoveTo command (spec 4.3.4.2)"};
+            }
+            // spec 4.3.4.2 "command count greater than 0"
+            if (m_count == 0) {
+                throw vtzero::geometry_exception{"MoveTo command count is zero (spec 4.3.4.2)"};
+            }
+            handler.points_begin(m_count);
+            decode_run([&](const vtzero::point p) { handler.points_point(p); });
+            if (m_it != m_end) {
+                throw vtzero::geometry_exception{"additional data after end of geometry (spec 4.3.4.2)"};
+            }
+            handler.points_end();
+        }
+
+        template <typename Handler>
+        void decode_linestring(Handler& handler) {
+            // spec 4.3.4.3 "1. A MoveTo command"
+            while (next_command(MOVE_TO)) {
+                // spec 4.3.4.3 "with a command count of 1"
+                if (m_count != 1) {
+                    throw vtzero::geometry_exception{"MoveTo command count is not 1 (spec 4.3.4.3)"};
+                }
+                const vtzero::point first_point = next_point();
+                // spec 4.3.4.3 "2. A LineTo command"
+                if (!next_command(LINE_TO)) {
+                    throw vtzero::geometry_exception{"expected LineTo command (spec 4.3.4.3)"};
+                }
+                // spec 4.3.4.3 "with a command count greater than 0"
+                if (m_count == 0) {
+                    throw vtzero::geometry_exception{"LineTo command count is zero (spec 4.3.4.3)"};
+                }
+                handler.linestring_begin(m_count + 1);
+                handler.linestring_point(first_point);
+                decode_run([&](const vtzero::point p) { handler.linestring_point(p); });
+                handler.linestring_end();
+            }
+        }
+
+        template <typename Handler>
+        void decode_polygon(Handler& handler) {
+            // spec 4.3.4.4 "1. A MoveTo command"
+            while (next_command(MOVE_TO)) {
+                // spec 4.3.4.4 "with a command count of 1"
+                if (m_count != 1) {
+                    throw vtzero::geometry_exception{"MoveTo command count is not 1 (spec 4.3.4.4)"};
+                }
+                const vtzero::point start_point = next_point();
+                vtzero::point last_point = start_point;
+                int64_t sum = 0;
+                // spec 4.3.4.4 "2. A LineTo command"
+                if (!next_command(LINE_TO)) {
+                    throw vtzero::geometry_exception{"expected LineTo command (spec 4.3.4.4)"};
+                }
+                handler.ring_begin(m_count + 2);
+                handler.ring_point(start_point);
+                decode_run([&](const vtzero::point p) {
+                    sum += det(last_point, p);
+                    last_point = p;
+                    handler.ring_point(p);
+                });
+                // spec 4.3.4.4 "3. A ClosePath command"
+                if (!next_command(CLOSE_PATH)) {
+                    throw vtzero::geometry_exception{"expected ClosePath command (4.3.4.4)"};
+                }
+                sum += det(last_point, start_point);
+                handler.ring_point(start_point);
+                handler.ring_end(sum > 0 ? vtzero::ring_type::outer
+                                         : sum < 0 ? vtzero::ring_type::inner : vtzero::ring_type::invalid);
+            }
+        }
+
+    private:
+        enum : uint32_t { MOVE_TO = 1, LINE_TO = 2, CLOSE_PATH = 7 };
+
+        const char* m_it;
+        const char* m_end;
+        uint32_t m_max_count;  // Each point takes at least two bytes
+        uint32_t m_count = 0;  // Points left in the current command
+        uint32_t m_x = 0;      // Cursor; unsigned so out of range deltas wrap like vtzero's cast
+        uint32_t m_y = 0;
+
+        static int64_t det(const vtzero::point a, const vtzero::point b) {
+            return static_cast<int64_t>(a.x) * b.y - static_cast<int64_t>(b.x) * a.y;
+        }
+
+        static uint32_t zigzag(uint32_t value) {
+            return (value >> 1U) ^ (0U - (value & 1U));
+        }
+
+        // Same value and errors as protozero::decode_varint, truncated to 32 bits
+        uint32_t read_varint() {
+            if (m_it != m_end && static_cast<uint8_t>(*m_it) < 0x80U) {
+                return static_cast<uint8_t>(*m_it++);
+            }
+            uint64_t value = 0;
+            for (unsigned shift = 0; shift < 70; shift += 7) {
+                if (m_it == m_end) throw protozero::end_of_buffer_exception{};
+                const auto byte = static_cast<uint8_t>(*m_it++);
+                value |= static_cast<uint64_t>(byte & 0x7fU) << shift;
+                if (byte < 0x80U) return static_cast<uint32_t>(value);
+            }
+            throw protozero::varint_too_long_exception{};
+        }
+
+        bool next_command(uint32_t expected) {
+            if (m_it == m_end) return false;
+            const uint32_t command = read_varint();
+            const uint32_t id = command & 0x7U;
+            if (id != expected) {
+                throw vtzero::geometry_exception{std::string{"expected command "} + std::to_string(expected) +
+                                                 " but got " + std::to_string(id)};
+            }
+            if (expected == CLOSE_PATH) {
+                // spec 4.3.3.3 "A ClosePath command MUST have a command count of 1"
+                if ((command >> 3U) != 1) {
+                    throw vtzero::geometry_exception{"ClosePath command count is not 1"};
+                }
+            } else {
+                m_count = command >> 3U;
+                if (m_count > m_max_count) {
+                    throw vtzero::geometry_exception{"count too large"};
+                }
+            }
+            return true;
+        }
+
+        vtzero::point next_point() {
+            if (m_it == m_end) throw vtzero::geometry_exception{"too few points in geometry"};
+            const uint32_t dx = read_varint();
+            if (m_it == m_end) throw vtzero::geometry_exception{"too few points in geometry"};
+            const uint32_t dy = read_varint();
+            m_x += zigzag(dx);
+            m_y += zigzag(dy);
+            --m_count;
+            return {static_cast<int32_t>(m_x), static_cast<int32_t>(m_y)};
+        }
+
+        // Decode the remaining points of the current command
+        template <typename Emit>
+        void decode_run(Emit&& emit) {
+            while (m_count > 0) {
+                if (m_end - m_it >= 2 &&
+                    ((static_cast<uint8_t>(m_it[0]) | static_cast<uint8_t>(m_it[1])) & 0x80U) == 0) {
+                    m_x += zigzag(static_cast<uint8_t>(m_it[0]));
+                    m_y += zigzag(static_cast<uint8_t>(m_it[1]));
+                    m_it += 2;
+                    --m_count;
+                    emit(vtzero::point{static_cast<int32_t>(m_x), static_cast<int32_t>(m_y)});
+                } else {
+                    emit(next_point());
+                }
+            }
+        }
+    };
+
+    // Decode a point, linestring or polygon geometry; other types are a geometry error
+    template <typename Handler>
+    void decode_feature_geometry(const vtzero::geometry& geometry, Handler& handler) {
+        GeometryCommandDecoder decoder{geometry};
+        switch (geometry.type()) {
+            case vtzero::GeomType::POINT:
+                decoder.decode_point(handler);
+                break;
+            case vtzero::GeomType::LINESTRING:
+                decoder.decode_linestring(handler);
+                break;
+            case vtzero::GeomType::POLYGON:
+                decoder.decode_polygon(handler);
+                break;
+            default:
+                throw vtzero::geometry_exception{"unknown geometry type"};
+        }
+    }
 }
 
 // Opaque handles for passing between C and C++
 struct VtzTileHandle {
     std::string data;
+    std::shared_ptr<TileCacheEntry> cache_entry;  // Set when served from a tile cache
     vtzero::vector_tile tile;
 
+    // Feature id indexes keyed by the start of the layer's data in the tile buffer
+    std::mutex feature_index_mutex;
+    std::unordered_map<const char*, std::shared_ptr<const FeatureIdIndex>> feature_indexes;
+
     VtzTileHandle(const char* bytes, size_t length)
-        : data(bytes, length), tile(data) {}
+        : data(bytes, length), tile(data) {
+        VTZ_STATS_ADD(live_tiles, 1);
+    }
+
+    // Takes ownership of an already decompressed buffer
+    explicit VtzTileHandle(std::string&& bytes)
+        : data(std::move(bytes)), tile(data) {
+        VTZ_STATS_ADD(live_tiles, 1);
+    }
+
+    // Shares the buffer of a cache entry, pinning it for the lifetime of the handle
+    explicit VtzTileHandle(std::shared_ptr<TileCacheEntry> entry)
+        : cache_entry(std::move(entry)), tile(cache_entry->data) {
+        cache_entry->pins.fetch_add(1, std::memory_order_relaxed);
+        VTZ_STATS_ADD(live_tiles, 1);
+    }
+
+    ~VtzTileHandle() {
+        VTZ_STATS_ADD(live_tiles, -1);
+        if (cache_entry) {
+            cache_entry->pins.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
 };
 
 struct VtzLayerHandle {
     vtzero::layer layer;
     std::string name_str;  // Store name to return stable pointer
+    VtzTileHandle* tile_handle;  // Owner of the layer data and its feature id index
 
-    VtzLayerHandle(vtzero::layer&& l) : layer(std::move(l)) {
+    VtzLayerHandle(vtzero::layer&& l, VtzTileHandle* tile = nullptr) : layer(std::move(l)), tile_handle(tile) {
         auto name_view = layer.name();
         name_str = std::string(name_view.data(), name_view.size());
+        VTZ_STATS_ADD(live_layers, 1);
+    }
+
+    ~VtzLayerHandle() {
+        VTZ_STATS_ADD(live_layers, -1);
     }
 };
 
 struct VtzFeatureHandle {
     vtzero::feature feature;
 
-    VtzFeatureHandle(vtzero::feature&& f) : feature(std::move(f)) {}
+    VtzFeatureHandle(vtzero::feature&& f) : feature(std::move(f)) {
+        VTZ_STATS_ADD(live_features, 1);
+    }
+
+    ~VtzFeatureHandle() {
+        VTZ_STATS_ADD(live_features, -1);
+    }
 };
 
 // Tile operations
 FFI_PLUGIN_EXPORT VtzTileHandle* vtz_tile_create(const uint8_t* data, size_t length) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_TILE_CREATE);
+    VTZ_STATS_TIME(VTZ_STATS_LATENCY_TILE_CREATE);
+    VTZ_STATS_ADD(bytes_processed, length);
     try {
         return new VtzTileHandle(reinterpret_cast<const char*>(data), length);
     } catch (...) {
@@ -69,11 +506,39 @@ FFI_PLUGIN_EXPORT VtzTileHandle* vtz_tile_create(const uint8_t* data, size_t len
     }
 }
 
+FFI_PLUGIN_EXPORT VtzTileHandle* vtz_tile_create_compressed(const uint8_t* data, size_t length) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_TILE_CREATE_COMPRESSED);
+    VTZ_STATS_TIME(VTZ_STATS_LATENCY_TILE_CREATE);
+    VTZ_STATS_ADD(bytes_processed, length);
+    clear_exception();
+    try {
+        if (!data) return nullptr;
+
+        const auto compression = detect_compression(data, length);
+        if (compression == TileCompression::none) {
+            return new VtzTileHandle(reinterpret_cast<const char*>(data), length);
+        }
+
+        return new VtzTileHandle(inflate_tile(data, length, compression));
+    } catch (const vtzero::format_exception& e) {
+        set_exception(VTZ_EXCEPTION_FORMAT, e.what());
+        return nullptr;
+    } catch (const std::exception& e) {
+        set_exception(VTZ_EXCEPTION_FORMAT, e.what());
+        return nullptr;
+    } catch (...) {
+        set_exception(VTZ_EXCEPTION_FORMAT, "Unknown exception");
+        return nullptr;
+    }
+}
+
 FFI_PLUGIN_EXPORT void vtz_tile_free(VtzTileHandle* handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_TILE_FREE);
     delete handle;
 }
 
 FFI_PLUGIN_EXPORT VtzLayerHandle* vtz_tile_next_layer(VtzTileHandle* tile_handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_TILE_NEXT_LAYER);
     clear_exception();
     try {
         if (!tile_handle) {
@@ -82,7 +547,7 @@ FFI_PLUGIN_EXPORT VtzLayerHandle* vtz_tile_next_layer(VtzTileHandle* tile_handle
 
         auto layer = tile_handle->tile.next_layer();
         if (layer.valid()) {
-            return new VtzLayerHandle(std::move(layer));
+            return new VtzLayerHandle(std::move(layer), tile_handle);
         }
 
         return nullptr;
@@ -102,6 +567,7 @@ FFI_PLUGIN_EXPORT VtzLayerHandle* vtz_tile_next_layer(VtzTileHandle* tile_handle
 }
 
 FFI_PLUGIN_EXPORT VtzLayerHandle* vtz_tile_get_layer_by_name(VtzTileHandle* tile_handle, const char* name) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_TILE_GET_LAYER_BY_NAME);
     clear_exception();
     try {
         if (!tile_handle || !name) return nullptr;
@@ -109,7 +575,186 @@ FFI_PLUGIN_EXPORT VtzLayerHandle* vtz_tile_get_layer_by_name(VtzTileHandle* tile
         auto layer = tile_handle->tile.get_layer_by_name(name);
         if (!layer) return nullptr;
 
-        return new VtzLayerHandle(std::move(layer));
+        return new VtzLayerHandle(std::move(layer), tile_handle);
+    } catch (const vtzero::format_exception& e) {
+        set_exception(VTZ_EXCEPTION_FORMAT, e.what());
+        return nullptr;
+    } catch (const std::exception& e) {
+        set_exception(VTZ_EXCEPTION_FORMAT, e.what());
+        return nullptr;
+    } catch (...) {
+        set_exception(VTZ_EXCEPTION_FORMAT, "Unknown exception");
+        return nullptr;
+    }
+}
+
+// Tile cache: sharded LRU of tile data keyed by (source, z, x, y)
+struct VtzTileCacheHandle {
+    struct Key {
+        uint64_t source;
+        uint32_t z;
+        uint32_t x;
+        uint32_t y;
+
+        bool operator==(const Key& other) const {
+            return source == other.source && z == other.z && x == other.x && y == other.y;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            // splitmix64 finalizer over the packed key
+            uint64_t h = key.source ^ (static_cast<uint64_t>(key.z) << 58) ^
+                         (static_cast<uint64_t>(key.x) << 29) ^ key.y;
+            h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+            return static_cast<size_t>(h ^ (h >> 31));
+        }
+    };
+
+    using LruList = std::list<std::pair<Key, std::shared_ptr<TileCacheEntry>>>;
+
+    struct Shard {
+        std::mutex mutex;
+        LruList lru;  // Most recently used first
+        std::unordered_map<Key, LruList::iterator, KeyHash> index;
+        size_t bytes = 0;
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    size_t byte_budget;
+    size_t shard_budget;
+
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+    std::atomic<uint64_t> evictions{0};
+
+    VtzTileCacheHandle(size_t budget, uint32_t shard_count)
+        : byte_budget(budget), shard_budget(budget / shard_count) {
+        shards.reserve(shard_count);
+        for (uint32_t i = 0; i < shard_count; ++i) {
+            shards.emplace_back(new Shard());
+        }
+    }
+
+    static size_t entry_size(const TileCacheEntry& entry) {
+        return entry.data.capacity() + sizeof(TileCacheEntry);
+    }
+
+    Shard& shard_for(const Key& key) {
+        return *shards[KeyHash{}(key) % shards.size()];
+    }
+
+    // Evict least recently used entries until the shard fits its budget.
+    // Pinned entries are skipped, so a shard may stay over budget while tiles are in use.
+    // Must be called with the shard mutex held.
+    void evict(Shard& shard) {
+        auto it = shard.lru.end();
+        while (shard.bytes > shard_budget && it != shard.lru.begin()) {
+            --it;
+            if (it->second->pins.load(std::memory_order_relaxed) > 0) {
+                continue;
+            }
+            shard.bytes -= entry_size(*it->second);
+            shard.index.erase(it->first);
+            it = shard.lru.erase(it);
+            evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+};
+
+FFI_PLUGIN_EXPORT VtzTileCacheHandle* vtz_tile_cache_create(size_t byte_budget, uint32_t shard_count) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_TILE_CACHE_CREATE);
+    try {
+        if (shard_count == 0) shard_count = 1;
+        return new VtzTileCacheHandle(byte_budget, shard_count);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+FFI_PLUGIN_EXPORT void vtz_tile_cache_free(VtzTileCacheHandle* cache) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_TILE_CACHE_FREE);
+    // Tile handles still in use keep their entries alive
+    delete cache;
+}
+
+FFI_PLUGIN_EXPORT VtzTileHandle* vtz_tile_cache_get(VtzTileCacheHandle* cache,
+                                                     uint64_t source,
+                                                     uint32_t z,
+                                                     uint32_t x,
+                                                     uint32_t y) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_TILE_CACHE_GET);
+    clear_exception();
+    if (!cache) return nullptr;
+
+    try {
+        const VtzTileCacheHandle::Key key{source, z, x, y};
+        auto& shard = cache->shard_for(key);
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto found = shard.index.find(key);
+        if (found == shard.index.end()) {
+            cache->misses.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        // Move to the front of the LRU list
+        shard.lru.splice(shard.lru.begin(), shard.lru, found->second);
+        cache->hits.fetch_add(1, std::memory_order_relaxed);
+        return new VtzTileHandle(found->second->second);
+    } catch (const std::exception& e) {
+        set_exception(VTZ_EXCEPTION_FORMAT, e.what());
+        return nullptr;
+    } catch (...) {
+        set_exception(VTZ_EXCEPTION_FORMAT, "Unknown exception");
+        return nullptr;
+    }
+}
+
+FFI_PLUGIN_EXPORT VtzTileHandle* vtz_tile_cache_put(VtzTileCacheHandle* cache,
+                                                     uint64_t source,
+                                                     uint32_t z,
+                                                     uint32_t x,
+                                                     uint32_t y,
+                                                     const uint8_t* data,
+                                                     size_t length) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_TILE_CACHE_PUT);
+    VTZ_STATS_TIME(VTZ_STATS_LATENCY_TILE_CREATE);
+    VTZ_STATS_ADD(bytes_processed, length);
+    clear_exception();
+    try {
+        if (!cache || !data) return nullptr;
+
+        // Inflate outside the shard lock
+        const auto compression = detect_compression(data, length);
+        std::string bytes = compression == TileCompression::none
+            ? std::string(reinterpret_cast<const char*>(data), length)
+            : inflate_tile(data, length, compression);
+
+        auto entry = std::make_shared<TileCacheEntry>(std::move(bytes));
+        // Create the handle first so the new entry is pinned during eviction,
+        // and own it until it is returned in case the insert throws
+        std::unique_ptr<VtzTileHandle> handle(new VtzTileHandle(entry));
+
+        const VtzTileCacheHandle::Key key{source, z, x, y};
+        auto& shard = cache->shard_for(key);
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto found = shard.index.find(key);
+        if (found != shard.index.end()) {
+            // Replace the existing entry, handles to the old one keep it alive
+            shard.bytes -= VtzTileCacheHandle::entry_size(*found->second->second);
+            shard.lru.erase(found->second);
+            shard.index.erase(found);
+        }
+
+        shard.lru.emplace_front(key, std::move(entry));
+        shard.index.emplace(key, shard.lru.begin());
+        shard.bytes += VtzTileCacheHandle::entry_size(*shard.lru.front().second);
+        cache->evict(shard);
+
+        return handle.release();
     } catch (const vtzero::format_exception& e) {
         set_exception(VTZ_EXCEPTION_FORMAT, e.what());
         return nullptr;
@@ -122,27 +767,97 @@ FFI_PLUGIN_EXPORT VtzLayerHandle* vtz_tile_get_layer_by_name(VtzTileHandle* tile
     }
 }
 
+FFI_PLUGIN_EXPORT bool vtz_tile_cache_remove(VtzTileCacheHandle* cache,
+                                             uint64_t source,
+                                             uint32_t z,
+                                             uint32_t x,
+                                             uint32_t y) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_TILE_CACHE_REMOVE);
+    if (!cache) return false;
+
+    const VtzTileCacheHandle::Key key{source, z, x, y};
+    auto& shard = cache->shard_for(key);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto found = shard.index.find(key);
+    if (found == shard.index.end()) return false;
+
+    shard.bytes -= VtzTileCacheHandle::entry_size(*found->second->second);
+    shard.lru.erase(found->second);
+    shard.index.erase(found);
+    return true;
+}
+
+FFI_PLUGIN_EXPORT void vtz_tile_cache_clear(VtzTileCacheHandle* cache) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_TILE_CACHE_CLEAR);
+    if (!cache) return;
+
+    for (auto& shard : cache->shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->index.clear();
+        shard->lru.clear();
+        shard->bytes = 0;
+    }
+}
+
+FFI_PLUGIN_EXPORT VtzTileCacheStats vtz_tile_cache_stats(VtzTileCacheHandle* cache) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_TILE_CACHE_STATS);
+    clear_exception();
+    VtzTileCacheStats stats = {0, 0, 0, 0, 0, 0, 0};
+    if (!cache) return stats;
+
+    try {
+        stats.hits = cache->hits.load(std::memory_order_relaxed);
+        stats.misses = cache->misses.load(std::memory_order_relaxed);
+        stats.evictions = cache->evictions.load(std::memory_order_relaxed);
+        stats.byte_budget = cache->byte_budget;
+
+        for (auto& shard : cache->shards) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            stats.entries += shard->index.size();
+            stats.bytes += shard->bytes;
+            for (const auto& item : shard->lru) {
+                if (item.second->pins.load(std::memory_order_relaxed) > 0) {
+                    ++stats.pinned;
+                }
+            }
+        }
+        return stats;
+    } catch (const std::exception& e) {
+        set_exception(VTZ_EXCEPTION_FORMAT, e.what());
+        return VtzTileCacheStats{0, 0, 0, 0, 0, 0, 0};
+    } catch (...) {
+        set_exception(VTZ_EXCEPTION_FORMAT, "Unknown exception");
+        return VtzTileCacheStats{0, 0, 0, 0, 0, 0, 0};
+    }
+}
+
 // Layer operations
 FFI_PLUGIN_EXPORT void vtz_layer_free(VtzLayerHandle* handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_LAYER_FREE);
     delete handle;
 }
 
 FFI_PLUGIN_EXPORT const char* vtz_layer_name(VtzLayerHandle* layer_handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_LAYER_NAME);
     if (!layer_handle) return nullptr;
     return layer_handle->name_str.c_str();
 }
 
 FFI_PLUGIN_EXPORT uint32_t vtz_layer_extent(VtzLayerHandle* layer_handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_LAYER_EXTENT);
     if (!layer_handle) return 4096;
     return layer_handle->layer.extent();
 }
 
 FFI_PLUGIN_EXPORT uint32_t vtz_layer_version(VtzLayerHandle* layer_handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_LAYER_VERSION);
     if (!layer_handle) return 0;
     return layer_handle->layer.version();
 }
 
 FFI_PLUGIN_EXPORT VtzFeatureHandle* vtz_layer_next_feature(VtzLayerHandle* layer_handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_LAYER_NEXT_FEATURE);
     clear_exception();
     try {
         if (!layer_handle) return nullptr;
@@ -163,39 +878,323 @@ FFI_PLUGIN_EXPORT VtzFeatureHandle* vtz_layer_next_feature(VtzLayerHandle* layer
     }
 }
 
-// Value table operations
-FFI_PLUGIN_EXPORT size_t vtz_layer_value_table_size(VtzLayerHandle* layer_handle) {
-    if (!layer_handle) return 0;
-    try {
-        // value_table_size() doesn't throw, but accessing value_table() might
-        // if it needs to initialize and encounters malformed data
-        return layer_handle->layer.value_table_size();
-    } catch (...) {
-        return 0;
+// Feature id index
+namespace {
+    std::shared_ptr<const FeatureIdIndex> find_feature_index(const VtzLayerHandle* layer_handle) {
+        auto* tile = layer_handle->tile_handle;
+        if (!tile) return nullptr;
+
+        std::lock_guard<std::mutex> lock(tile->feature_index_mutex);
+        auto it = tile->feature_indexes.find(layer_handle->layer.data().data());
+        return it == tile->feature_indexes.end() ? nullptr : it->second;
     }
-}
 
-// Property value handle - stores the data_view from layer
-struct VtzPropertyValueHandle {
-    vtzero::property_value value;
-    std::string string_storage; // For string values
+    // One pass over the layer's feature messages into index. With filter set,
+    // only the ids already present in index are filled in.
+    void index_layer_features(const vtzero::layer& layer, FeatureIdIndex& index, bool filter) {
+        protozero::pbf_message<vtzero::detail::pbf_layer> reader{layer.data()};
+        while (reader.next(vtzero::detail::pbf_layer::features)) {
+            const auto view = reader.get_view();
+            const vtzero::feature feature{&layer, view};
+            if (!feature.has_id()) continue;
+
+            if (filter) {
+                auto it = index.find(feature.id());
+                if (it != index.end() && it->second.data() == nullptr) {
+                    it->second = view;
+                }
+            } else {
+                index.emplace(feature.id(), view);
+            }
+        }
+    }
 
-    VtzPropertyValueHandle(const vtzero::property_value& pv) : value(pv) {
-        // Store string value if needed
-        if (pv.type() == vtzero::property_value_type::string_value) {
-            auto view = pv.string_value();
-            string_storage = std::string(view.data(), view.size());
+    void free_feature_handles(VtzFeatureHandle** handles, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            delete handles[i];
+            handles[i] = nullptr;
         }
     }
-};
+}
 
-FFI_PLUGIN_EXPORT VtzPropertyValueHandle* vtz_layer_value(VtzLayerHandle* layer_handle, uint32_t index) {
+FFI_PLUGIN_EXPORT size_t vtz_layer_build_feature_index(VtzLayerHandle* layer_handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_LAYER_BUILD_FEATURE_INDEX);
     clear_exception();
-    if (!layer_handle) return nullptr;
     try {
-        vtzero::index_value idx(index);
-        // value() may call value_table() which may initialize the table
-        // This should not throw for malformed values - only accessing type() throws
+        if (!layer_handle || !layer_handle->tile_handle) return 0;
+
+        if (auto existing = find_feature_index(layer_handle)) {
+            return existing->size();
+        }
+
+        auto index = std::make_shared<FeatureIdIndex>();
+        index->reserve(layer_handle->layer.num_features());
+        index_layer_features(layer_handle->layer, *index, false);
+
+        // Another layer handle of the same tile may have built it meanwhile; keep the first
+        auto* tile = layer_handle->tile_handle;
+        std::lock_guard<std::mutex> lock(tile->feature_index_mutex);
+        auto inserted = tile->feature_indexes.emplace(layer_handle->layer.data().data(), std::move(index));
+        return inserted.first->second->size();
+    } catch (const vtzero::format_exception& e) {
+        set_exception(VTZ_EXCEPTION_FORMAT, e.what());
+        return 0;
+    } catch (const std::exception& e) {
+        set_exception(VTZ_EXCEPTION_FORMAT, e.what());
+        return 0;
+    } catch (...) {
+        set_exception(VTZ_EXCEPTION_FORMAT, "Unknown exception");
+        return 0;
+    }
+}
+
+FFI_PLUGIN_EXPORT VtzFeatureHandle* vtz_layer_get_feature_by_id(VtzLayerHandle* layer_handle, uint64_t id) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_LAYER_GET_FEATURE_BY_ID);
+    clear_exception();
+    try {
+        if (!layer_handle) return nullptr;
+
+        if (auto index = find_feature_index(layer_handle)) {
+            auto it = index->find(id);
+            if (it == index->end()) return nullptr;
+            return new VtzFeatureHandle(vtzero::feature{&layer_handle->layer, it->second});
+        }
+
+        // No index: linear scan
+        auto feature = layer_handle->layer.get_feature_by_id(id);
+        if (!feature) return nullptr;
+
+        return new VtzFeatureHandle(std::move(feature));
+    } catch (const vtzero::format_exception& e) {
+        set_exception(VTZ_EXCEPTION_FORMAT, e.what());
+        return nullptr;
+    } catch (const std::exception& e) {
+        set_exception(VTZ_EXCEPTION_FORMAT, e.what());
+        return nullptr;
+    } catch (...) {
+        set_exception(VTZ_EXCEPTION_FORMAT, "Unknown exception");
+        return nullptr;
+    }
+}
+
+FFI_PLUGIN_EXPORT size_t vtz_layer_get_features_by_ids(VtzLayerHandle* layer_handle,
+                                                        const uint64_t* ids,
+                                                        size_t count,
+                                                        VtzFeatureHandle** out_features) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_LAYER_GET_FEATURES_BY_IDS);
+    clear_exception();
+    if (!layer_handle || !ids || !out_features) return 0;
+    std::fill(out_features, out_features + count, nullptr);
+
+    try {
+        auto index = find_feature_index(layer_handle);
+        if (!index) {
+            // No index: a single scan that only records the requested ids
+            auto wanted = std::make_shared<FeatureIdIndex>();
+            wanted->reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                wanted->emplace(ids[i], vtzero::data_view{});
+            }
+            index_layer_features(layer_handle->layer, *wanted, true);
+            index = std::move(wanted);
+        }
+
+        size_t found = 0;
+        for (size_t i = 0; i < count; ++i) {
+            auto it = index->find(ids[i]);
+            if (it == index->end() || it->second.data() == nullptr) continue;
+            out_features[i] = new VtzFeatureHandle(vtzero::feature{&layer_handle->layer, it->second});
+            ++found;
+        }
+        return found;
+    } catch (const vtzero::format_exception& e) {
+        free_feature_handles(out_features, count);
+        set_exception(VTZ_EXCEPTION_FORMAT, e.what());
+        return 0;
+    } catch (const std::exception& e) {
+        free_feature_handles(out_features, count);
+        set_exception(VTZ_EXCEPTION_FORMAT, e.what());
+        return 0;
+    } catch (...) {
+        free_feature_handles(out_features, count);
+        set_exception(VTZ_EXCEPTION_FORMAT, "Unknown exception");
+        return 0;
+    }
+}
+
+// Content hashing
+namespace {
+    // XXH64 (https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md). Input words are
+    // read as little-endian on every platform so hashes can be persisted and shared.
+    const uint64_t XXH_PRIME64_1 = 0x9E3779B185EBCA87ULL;
+    const uint64_t XXH_PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+    const uint64_t XXH_PRIME64_3 = 0x165667B19E3779F9ULL;
+    const uint64_t XXH_PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+    const uint64_t XXH_PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+    inline uint64_t xxh_rotl(uint64_t x, int r) {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    inline uint64_t xxh_read64(const unsigned char* p) {
+        return static_cast<uint64_t>(p[0]) | static_cast<uint64_t>(p[1]) << 8 |
+               static_cast<uint64_t>(p[2]) << 16 | static_cast<uint64_t>(p[3]) << 24 |
+               static_cast<uint64_t>(p[4]) << 32 | static_cast<uint64_t>(p[5]) << 40 |
+               static_cast<uint64_t>(p[6]) << 48 | static_cast<uint64_t>(p[7]) << 56;
+    }
+
+    inline uint64_t xxh_read32(const unsigned char* p) {
+        return static_cast<uint64_t>(p[0]) | static_cast<uint64_t>(p[1]) << 8 |
+               static_cast<uint64_t>(p[2]) << 16 | static_cast<uint64_t>(p[3]) << 24;
+    }
+
+    inline uint64_t xxh_round(uint64_t acc, uint64_t input) {
+        acc += input * XXH_PRIME64_2;
+        return xxh_rotl(acc, 31) * XXH_PRIME64_1;
+    }
+
+    inline uint64_t xxh_merge_round(uint64_t acc, uint64_t value) {
+        acc ^= xxh_round(0, value);
+        return acc * XXH_PRIME64_1 + XXH_PRIME64_4;
+    }
+
+    uint64_t xxh64(const char* data, size_t length, uint64_t seed = 0) {
+        const auto* p = reinterpret_cast<const unsigned char*>(data);
+        const unsigned char* const end = p + length;
+        uint64_t h;
+
+        if (length >= 32) {
+            // Four independent lanes over 32 byte stripes
+            uint64_t v1 = seed + XXH_PRIME64_1 + XXH_PRIME64_2;
+            uint64_t v2 = seed + XXH_PRIME64_2;
+            uint64_t v3 = seed;
+            uint64_t v4 = seed - XXH_PRIME64_1;
+            const unsigned char* const limit = end - 32;
+            do {
+                v1 = xxh_round(v1, xxh_read64(p));
+                v2 = xxh_round(v2, xxh_read64(p + 8));
+                v3 = xxh_round(v3, xxh_read64(p + 16));
+                v4 = xxh_round(v4, xxh_read64(p + 24));
+                p += 32;
+            } while (p <= limit);
+
+            h = xxh_rotl(v1, 1) + xxh_rotl(v2, 7) + xxh_rotl(v3, 12) + xxh_rotl(v4, 18);
+            h = xxh_merge_round(h, v1);
+            h = xxh_merge_round(h, v2);
+            h = xxh_merge_round(h, v3);
+            h = xxh_merge_round(h, v4);
+        } else {
+            h = seed + XXH_PRIME64_5;
+        }
+
+        h += static_cast<uint64_t>(length);
+
+        for (; end - p >= 8; p += 8) {
+            h ^= xxh_round(0, xxh_read64(p));
+            h = xxh_rotl(h, 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+        }
+        if (end - p >= 4) {
+            h ^= xxh_read32(p) * XXH_PRIME64_1;
+            h = xxh_rotl(h, 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+            p += 4;
+        }
+        for (; p < end; ++p) {
+            h ^= *p * XXH_PRIME64_5;
+            h = xxh_rotl(h, 11) * XXH_PRIME64_1;
+        }
+
+        // Avalanche
+        h ^= h >> 33;
+        h *= XXH_PRIME64_2;
+        h ^= h >> 29;
+        h *= XXH_PRIME64_3;
+        h ^= h >> 32;
+        return h;
+    }
+}
+
+FFI_PLUGIN_EXPORT uint64_t vtz_tile_hash(VtzTileHandle* tile_handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_TILE_HASH);
+    if (!tile_handle) return 0;
+    const std::string& data = tile_handle->cache_entry ? tile_handle->cache_entry->data : tile_handle->data;
+    return xxh64(data.data(), data.size());
+}
+
+FFI_PLUGIN_EXPORT uint64_t vtz_layer_hash(VtzLayerHandle* layer_handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_LAYER_HASH);
+    if (!layer_handle) return 0;
+    const auto data = layer_handle->layer.data();
+    return xxh64(data.data(), data.size());
+}
+
+FFI_PLUGIN_EXPORT size_t vtz_layer_feature_hashes(VtzLayerHandle* layer_handle,
+                                                   uint64_t* out_hashes,
+                                                   size_t capacity) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_LAYER_FEATURE_HASHES);
+    clear_exception();
+    if (!layer_handle) return 0;
+
+    try {
+        // Hash the raw feature messages without parsing them
+        protozero::pbf_message<vtzero::detail::pbf_layer> reader{layer_handle->layer.data()};
+        size_t count = 0;
+        while (reader.next(vtzero::detail::pbf_layer::features)) {
+            const auto view = reader.get_view();
+            if (out_hashes && count < capacity) {
+                out_hashes[count] = xxh64(view.data(), view.size());
+            }
+            ++count;
+        }
+        return count;
+    } catch (const std::exception& e) {
+        set_exception(VTZ_EXCEPTION_FORMAT, e.what());
+        return 0;
+    } catch (...) {
+        set_exception(VTZ_EXCEPTION_FORMAT, "Unknown exception");
+        return 0;
+    }
+}
+
+// Value table operations
+FFI_PLUGIN_EXPORT size_t vtz_layer_value_table_size(VtzLayerHandle* layer_handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_LAYER_VALUE_TABLE_SIZE);
+    if (!layer_handle) return 0;
+    try {
+        // value_table_size() doesn't throw, but accessing value_table() might
+        // if it needs to initialize and encounters malformed data
+        return layer_handle->layer.value_table_size();
+    } catch (...) {
+        return 0;
+    }
+}
+
+// Property value handle - stores the data_view from layer
+struct VtzPropertyValueHandle {
+    vtzero::property_value value;
+    std::string string_storage; // For string values
+
+    VtzPropertyValueHandle(const vtzero::property_value& pv) : value(pv) {
+        // Store string value if needed
+        if (pv.type() == vtzero::property_value_type::string_value) {
+            auto view = pv.string_value();
+            string_storage = std::string(view.data(), view.size());
+        }
+        VTZ_STATS_ADD(live_property_values, 1);
+    }
+
+    ~VtzPropertyValueHandle() {
+        VTZ_STATS_ADD(live_property_values, -1);
+    }
+};
+
+FFI_PLUGIN_EXPORT VtzPropertyValueHandle* vtz_layer_value(VtzLayerHandle* layer_handle, uint32_t index) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_LAYER_VALUE);
+    clear_exception();
+    if (!layer_handle) return nullptr;
+    try {
+        vtzero::index_value idx(index);
+        // value() may call value_table() which may initialize the table
+        // This should not throw for malformed values - only accessing type() throws
         auto pv = layer_handle->layer.value(idx);
         return new VtzPropertyValueHandle(pv);
     } catch (const vtzero::out_of_range_exception& e) {
@@ -214,10 +1213,12 @@ FFI_PLUGIN_EXPORT VtzPropertyValueHandle* vtz_layer_value(VtzLayerHandle* layer_
 }
 
 FFI_PLUGIN_EXPORT void vtz_property_value_free(VtzPropertyValueHandle* handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_PROPERTY_VALUE_FREE);
     delete handle;
 }
 
 FFI_PLUGIN_EXPORT int32_t vtz_property_value_type(VtzPropertyValueHandle* handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_PROPERTY_VALUE_TYPE);
     clear_exception();
     if (!handle) return -1;
     try {
@@ -245,6 +1246,7 @@ FFI_PLUGIN_EXPORT int32_t vtz_property_value_type(VtzPropertyValueHandle* handle
 }
 
 FFI_PLUGIN_EXPORT const char* vtz_property_value_string(VtzPropertyValueHandle* handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_PROPERTY_VALUE_STRING);
     clear_exception();
     if (!handle) return nullptr;
     try {
@@ -267,6 +1269,7 @@ FFI_PLUGIN_EXPORT const char* vtz_property_value_string(VtzPropertyValueHandle*
 }
 
 FFI_PLUGIN_EXPORT float vtz_property_value_float(VtzPropertyValueHandle* handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_PROPERTY_VALUE_FLOAT);
     clear_exception();
     if (!handle) return 0.0f;
     try {
@@ -284,6 +1287,7 @@ FFI_PLUGIN_EXPORT float vtz_property_value_float(VtzPropertyValueHandle* handle)
 }
 
 FFI_PLUGIN_EXPORT double vtz_property_value_double(VtzPropertyValueHandle* handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_PROPERTY_VALUE_DOUBLE);
     clear_exception();
     if (!handle) return 0.0;
     try {
@@ -301,6 +1305,7 @@ FFI_PLUGIN_EXPORT double vtz_property_value_double(VtzPropertyValueHandle* handl
 }
 
 FFI_PLUGIN_EXPORT int64_t vtz_property_value_int(VtzPropertyValueHandle* handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_PROPERTY_VALUE_INT);
     clear_exception();
     if (!handle) return 0;
     try {
@@ -318,6 +1323,7 @@ FFI_PLUGIN_EXPORT int64_t vtz_property_value_int(VtzPropertyValueHandle* handle)
 }
 
 FFI_PLUGIN_EXPORT uint64_t vtz_property_value_uint(VtzPropertyValueHandle* handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_PROPERTY_VALUE_UINT);
     clear_exception();
     if (!handle) return 0;
     try {
@@ -335,6 +1341,7 @@ FFI_PLUGIN_EXPORT uint64_t vtz_property_value_uint(VtzPropertyValueHandle* handl
 }
 
 FFI_PLUGIN_EXPORT int64_t vtz_property_value_sint(VtzPropertyValueHandle* handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_PROPERTY_VALUE_SINT);
     clear_exception();
     if (!handle) return 0;
     try {
@@ -352,6 +1359,7 @@ FFI_PLUGIN_EXPORT int64_t vtz_property_value_sint(VtzPropertyValueHandle* handle
 }
 
 FFI_PLUGIN_EXPORT bool vtz_property_value_bool(VtzPropertyValueHandle* handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_PROPERTY_VALUE_BOOL);
     clear_exception();
     if (!handle) return false;
     try {
@@ -370,20 +1378,24 @@ FFI_PLUGIN_EXPORT bool vtz_property_value_bool(VtzPropertyValueHandle* handle) {
 
 // Feature operations
 FFI_PLUGIN_EXPORT void vtz_feature_free(VtzFeatureHandle* handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_FEATURE_FREE);
     delete handle;
 }
 
 FFI_PLUGIN_EXPORT uint32_t vtz_feature_geometry_type(VtzFeatureHandle* feature_handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_FEATURE_GEOMETRY_TYPE);
     if (!feature_handle) return 0;
     return static_cast<uint32_t>(feature_handle->feature.geometry_type());
 }
 
 FFI_PLUGIN_EXPORT bool vtz_feature_has_id(VtzFeatureHandle* feature_handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_FEATURE_HAS_ID);
     if (!feature_handle) return false;
     return feature_handle->feature.has_id();
 }
 
 FFI_PLUGIN_EXPORT uint64_t vtz_feature_id(VtzFeatureHandle* feature_handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_FEATURE_ID);
     if (!feature_handle) return 0;
     return feature_handle->feature.id();
 }
@@ -396,6 +1408,8 @@ typedef void (*PropertyCallback)(void* user_data, const char* key, int32_t value
 FFI_PLUGIN_EXPORT void vtz_feature_for_each_property(VtzFeatureHandle* feature_handle,
                                                        PropertyCallback callback,
                                                        void* user_data) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_FEATURE_FOR_EACH_PROPERTY);
+    VTZ_STATS_TIME(VTZ_STATS_LATENCY_PROPERTY_ITERATION);
     clear_exception();
     if (!feature_handle || !callback) return;
 
@@ -435,6 +1449,7 @@ FFI_PLUGIN_EXPORT void vtz_feature_for_each_property(VtzFeatureHandle* feature_h
 
 // Property index operations
 FFI_PLUGIN_EXPORT VtzPropertyIndexPair vtz_feature_next_property_indexes(VtzFeatureHandle* feature_handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_FEATURE_NEXT_PROPERTY_INDEXES);
     clear_exception();
     VtzPropertyIndexPair result = {0, 0, false};
     if (!feature_handle) return result;
@@ -457,6 +1472,7 @@ FFI_PLUGIN_EXPORT VtzPropertyIndexPair vtz_feature_next_property_indexes(VtzFeat
 }
 
 FFI_PLUGIN_EXPORT void vtz_feature_reset_property(VtzFeatureHandle* feature_handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_FEATURE_RESET_PROPERTY);
     if (!feature_handle) return;
     try {
         feature_handle->feature.reset_property();
@@ -470,6 +1486,8 @@ typedef void (*PropertyIndexCallback)(void* user_data, uint32_t key_index, uint3
 FFI_PLUGIN_EXPORT bool vtz_feature_for_each_property_indexes(VtzFeatureHandle* feature_handle,
                                                               PropertyIndexCallback callback,
                                                               void* user_data) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_FEATURE_FOR_EACH_PROPERTY_INDEXES);
+    VTZ_STATS_TIME(VTZ_STATS_LATENCY_PROPERTY_ITERATION);
     clear_exception();
     if (!feature_handle || !callback) return false;
 
@@ -500,6 +1518,7 @@ struct GeometryHandler {
 
     // Point geometry callbacks
     void points_begin(uint32_t count) {
+        VTZ_STATS_ADD(vertices_emitted, count);
         callback(user_data, 1, count, 0); // Command 1 = points_begin
     }
 
@@ -513,6 +1532,7 @@ struct GeometryHandler {
 
     // Linestring geometry callbacks
     void linestring_begin(uint32_t count) {
+        VTZ_STATS_ADD(vertices_emitted, count);
         callback(user_data, 4, count, 0); // Command 4 = linestring_begin
     }
 
@@ -526,6 +1546,7 @@ struct GeometryHandler {
 
     // Polygon ring callbacks
     void ring_begin(uint32_t count) {
+        VTZ_STATS_ADD(vertices_emitted, count);
         callback(user_data, 7, count, 0); // Command 7 = ring_begin
     }
 
@@ -541,29 +1562,16 @@ struct GeometryHandler {
 FFI_PLUGIN_EXPORT int vtz_feature_decode_geometry(VtzFeatureHandle* feature_handle,
                                                      GeometryCallback callback,
                                                      void* user_data) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_FEATURE_DECODE_GEOMETRY);
+    VTZ_STATS_TIME(VTZ_STATS_LATENCY_GEOMETRY_DECODE);
     clear_exception();
     if (!feature_handle || !callback) return -1;
 
     try {
-        auto geometry = feature_handle->feature.geometry();
         GeometryHandler handler{callback, user_data};
 
-        // Check geometry type and use appropriate decode function
-        // For unknown types, throw geometry_exception to match C++ behavior
-        switch (geometry.type()) {
-            case vtzero::GeomType::POINT:
-                vtzero::decode_point_geometry(geometry, handler);
-                break;
-            case vtzero::GeomType::LINESTRING:
-                vtzero::decode_linestring_geometry(geometry, handler);
-                break;
-            case vtzero::GeomType::POLYGON:
-                vtzero::decode_polygon_geometry(geometry, handler);
-                break;
-            default:
-                // Unknown geometry type - throw geometry_exception to match C++ behavior
-                throw vtzero::geometry_exception{"unknown geometry type"};
-        }
+        // For unknown types, throws geometry_exception to match C++ behavior
+        decode_feature_geometry(feature_handle->feature.geometry(), handler);
         return 0; // Success
     } catch (const vtzero::geometry_exception& e) {
         set_exception(VTZ_EXCEPTION_GEOMETRY, e.what());
@@ -577,199 +1585,298 @@ FFI_PLUGIN_EXPORT int vtz_feature_decode_geometry(VtzFeatureHandle* feature_hand
     }
 }
 
-// GeoJSON handler that projects coordinates to lon/lat
-struct GeoJsonHandler {
-    GeoJsonCallback callback;
-    void* user_data;
-    uint32_t extent;
-    int32_t tile_x;
-    int32_t tile_y;
-    uint32_t tile_z;
-
-    double size;
-    double x0;
-    double y0;
-
-    // For polygon rings: collect points and fix winding order
-    std::vector<std::pair<double, double>> current_ring;
-    bool is_polygon_ring;
-
-    GeoJsonHandler(GeoJsonCallback cb, void* data, uint32_t ext, int32_t tx, int32_t ty, uint32_t tz)
-        : callback(cb), user_data(data), extent(ext), tile_x(tx), tile_y(ty), tile_z(tz), is_polygon_ring(false) {
-        size = static_cast<double>(extent) * (1 << tz); // extent * 2^z
-        x0 = static_cast<double>(extent) * tile_x;
-        y0 = static_cast<double>(extent) * tile_y;
-    }
-
-    // Project point from tile coordinates to lon/lat
-    void project_point(int32_t x, int32_t y, double& lon, double& lat) {
-        // Convert to lon/lat using Web Mercator projection
-        // See: https://wiki.openstreetmap.org/wiki/Slippy_map_tilenames
-        double y2 = 180.0 - (y + y0) * 360.0 / size;
-        lon = (x + x0) * 360.0 / size - 180.0;
-        lat = 360.0 / M_PI * atan(exp(y2 * M_PI / 180.0)) - 90.0;
-    }
-
-    // Calculate if ring is counter-clockwise using shoelace formula
-    // Implements https://en.wikipedia.org/wiki/Shoelace_formula
-    // Matches vector_tile package implementation:
-    // for (var i = 0, j = ringLength - 1; i < ringLength; j = i++) {
-    //   sum += (ring[i][0] - ring[j][0]) * (ring[i][1] + ring[j][1]);
-    // }
-    // Returns true if counter-clockwise (sum < 0), false if clockwise (sum >= 0)
-    bool is_counter_clockwise(const std::vector<std::pair<double, double>>& ring) {
-        if (ring.size() < 3) return true; // Default to counter-clockwise for invalid rings
-        
-        double sum = 0.0;
-        size_t n = ring.size();
-        size_t effective_n = n;
-        
-        // Check if ring is closed (first point == last point)
-        // Use epsilon comparison for floating point coordinates
-        const double epsilon = 1e-10;
-        if (n > 3 && 
-            std::abs(ring[0].first - ring[n-1].first) < epsilon &&
-            std::abs(ring[0].second - ring[n-1].second) < epsilon) {
-            effective_n = n - 1; // Skip duplicate closing point
-        }
-        
-        // Match vector_tile implementation: j starts at last index, then j = i, i increments
-        // This means: j is previous index, i is current index
-        // Formula: (current.x - previous.x) * (current.y + previous.y)
-        for (size_t i = 0, j = effective_n - 1; i < effective_n; j = i++) {
-            const double& current_x = ring[i].first;
-            const double& current_y = ring[i].second;
-            const double& previous_x = ring[j].first;
-            const double& previous_y = ring[j].second;
-            
-            sum += (current_x - previous_x) * (current_y + previous_y);
-        }
-        
-        // Counter-clockwise if sum < 0 (matches vector_tile)
-        return sum < 0.0;
-    }
-
-    // Emit ring points, reversing if needed to follow GeoJSON right-hand rule
-    void emit_ring(bool is_outer) {
-        if (current_ring.size() < 3) {
-            // Invalid ring, skip it
-            current_ring.clear();
-            return;
-        }
-
-        // Check if ring is closed (first point == last point)
-        // Use epsilon comparison for floating point coordinates
-        const double epsilon = 1e-10;
-        bool is_closed = (current_ring.size() > 3 &&
-                         std::abs(current_ring[0].first - current_ring[current_ring.size()-1].first) < epsilon &&
-                         std::abs(current_ring[0].second - current_ring[current_ring.size()-1].second) < epsilon);
-        
-        // Ensure ring is closed for GeoJSON (first point == last point)
-        // GeoJSON spec requires all rings to be closed
-        if (!is_closed && current_ring.size() >= 2) {
-            // Add closing point if not already closed
-            current_ring.push_back(current_ring[0]);
-            is_closed = true;
-        }
-        
-        // Check if ring is counter-clockwise using the validation library's formula
-        // sum += (next.x - current.x) * (next.y + current.y)
-        // Counter-clockwise if sum < 0
-        bool is_ccw = is_counter_clockwise(current_ring);
-        
-        // All rings must be counter-clockwise according to the validation library
-        // If the ring is not counter-clockwise, reverse it
-        bool should_reverse = !is_ccw;
-
-        // Emit ring
-        callback(user_data, 0, 0, 0); // BEGIN_RING
-        
-        if (should_reverse) {
-            // Reverse the ring to fix winding order
-            // For a closed ring [A, B, C, A], we want [A, C, B, A]
-            // We need to reverse all points except keep the first point as both start and end
-            if (is_closed && current_ring.size() > 1) {
-                // Emit first point (which will be both start and end)
-                callback(user_data, 1, current_ring[0].first, current_ring[0].second);
-                // Reverse and emit all points except the first and last (duplicate)
-                // Go from second-to-last down to second
-                for (size_t i = current_ring.size() - 2; i >= 1; --i) {
-                    callback(user_data, 1, current_ring[i].first, current_ring[i].second);
-                    if (i == 1) break; // Prevent underflow
+// Projection pipeline
+// Geometry is decoded through a ProjectingHandler templated on a projection policy, which maps
+// tile coordinates to output coordinates, and a sink policy, which receives the projected parts.
+// Both are resolved at compile time, so every combination is a direct loop without per-point
+// indirect calls or branches on the projection kind.
+namespace {
+    // Tile coordinates as doubles
+    struct TileProjection {
+        explicit TileProjection(const VtzProjectionParams&) {}
+
+        void operator()(int32_t x, int32_t y, double& ox, double& oy) const {
+            ox = x;
+            oy = y;
+        }
+    };
+
+    // Web Mercator tile coordinates to WGS84 lon/lat
+    // See: https://wiki.openstreetmap.org/wiki/Slippy_map_tilenames
+    struct Wgs84Projection {
+        double size;
+        double x0;
+        double y0;
+
+        Wgs84Projection(uint32_t extent, int32_t tile_x, int32_t tile_y, uint32_t tile_z)
+            : size(static_cast<double>(extent) * std::ldexp(1.0, static_cast<int>(tile_z))),  // extent * 2^z
+              x0(static_cast<double>(extent) * tile_x),
+              y0(static_cast<double>(extent) * tile_y) {}
+
+        explicit Wgs84Projection(const VtzProjectionParams& params)
+            : Wgs84Projection(params.extent, static_cast<int32_t>(params.tile_x),
+                              static_cast<int32_t>(params.tile_y), params.tile_z) {}
+
+        void operator()(int32_t x, int32_t y, double& lon, double& lat) const {
+            const double y2 = 180.0 - (y + y0) * 360.0 / size;
+            lon = (x + x0) * 360.0 / size - 180.0;
+            lat = 360.0 / M_PI * atan(exp(y2 * M_PI / 180.0)) - 90.0;
+        }
+    };
+
+    // Web Mercator tile coordinates to EPSG:3857 meters
+    struct MercatorMetersProjection {
+        double scale;
+        double x0;
+        double y0;
+
+        explicit MercatorMetersProjection(const VtzProjectionParams& params) {
+            const double circumference = 2.0 * M_PI * 6378137.0;
+            const double extent = params.extent;
+            scale = circumference / (extent * std::ldexp(1.0, static_cast<int>(params.tile_z)));
+            x0 = extent * params.tile_x * scale - circumference / 2.0;
+            y0 = circumference / 2.0 - extent * params.tile_y * scale;
+        }
+
+        void operator()(int32_t x, int32_t y, double& ox, double& oy) const {
+            ox = x0 + x * scale;
+            oy = y0 - y * scale;
+        }
+    };
+
+    // Affine transform of tile coordinates, e.g. to screen pixels
+    struct AffineProjection {
+        double a, b, c, d, e, f;
+
+        explicit AffineProjection(const VtzProjectionParams& params)
+            : a(params.affine[0]), b(params.affine[1]), c(params.affine[2]),
+              d(params.affine[3]), e(params.affine[4]), f(params.affine[5]) {}
+
+        void operator()(int32_t x, int32_t y, double& ox, double& oy) const {
+            ox = a * x + b * y + c;
+            oy = d * x + e * y + f;
+        }
+    };
+
+    // Writes parts into caller provided arrays. What does not fit is counted but not
+    // written, so callers can retry with larger buffers.
+    struct ArraySink {
+        VtzProjectedGeometry& out;
+
+        void part_begin(uint32_t /*count*/) {
+            if (out.part_count < out.part_capacity) {
+                out.part_offsets[out.part_count] = static_cast<uint32_t>(out.point_count);
+            }
+            ++out.part_count;
+        }
+
+        void point(double x, double y) {
+            if (out.point_count < out.point_capacity) {
+                out.coordinates[out.point_count * 2] = x;
+                out.coordinates[out.point_count * 2 + 1] = y;
+            }
+            ++out.point_count;
+        }
+
+        void part_end() {}
+
+        void ring_begin(uint32_t count) { part_begin(count); }
+        void ring_point(double x, double y) { point(x, y); }
+        void ring_end(vtzero::ring_type /*rt*/) {}
+    };
+
+    // GeoJSON output through a callback. Polygon rings are collected so they can be
+    // closed and oriented counter-clockwise before they are emitted.
+    struct GeoJsonSink {
+        GeoJsonCallback callback;
+        void* user_data;
+
+        std::vector<std::pair<double, double>> current_ring;
+
+        GeoJsonSink(GeoJsonCallback cb, void* data) : callback(cb), user_data(data) {}
+
+        // Calculate if ring is counter-clockwise using shoelace formula
+        // Implements https://en.wikipedia.org/wiki/Shoelace_formula
+        // Matches vector_tile package implementation:
+        // for (var i = 0, j = ringLength - 1; i < ringLength; j = i++) {
+        //   sum += (ring[i][0] - ring[j][0]) * (ring[i][1] + ring[j][1]);
+        // }
+        // Returns true if counter-clockwise (sum < 0), false if clockwise (sum >= 0)
+        bool is_counter_clockwise(const std::vector<std::pair<double, double>>& ring) {
+            if (ring.size() < 3) return true; // Default to counter-clockwise for invalid rings
+
+            double sum = 0.0;
+            size_t n = ring.size();
+            size_t effective_n = n;
+
+            // Check if ring is closed (first point == last point)
+            // Use epsilon comparison for floating point coordinates
+            const double epsilon = 1e-10;
+            if (n > 3 &&
+                std::abs(ring[0].first - ring[n-1].first) < epsilon &&
+                std::abs(ring[0].second - ring[n-1].second) < epsilon) {
+                effective_n = n - 1; // Skip duplicate closing point
+            }
+
+            // Match vector_tile implementation: j starts at last index, then j = i, i increments
+            // This means: j is previous index, i is current index
+            // Formula: (current.x - previous.x) * (current.y + previous.y)
+            for (size_t i = 0, j = effective_n - 1; i < effective_n; j = i++) {
+                const double& current_x = ring[i].first;
+                const double& current_y = ring[i].second;
+                const double& previous_x = ring[j].first;
+                const double& previous_y = ring[j].second;
+
+                sum += (current_x - previous_x) * (current_y + previous_y);
+            }
+
+            // Counter-clockwise if sum < 0 (matches vector_tile)
+            return sum < 0.0;
+        }
+
+        // Emit ring points, reversing if needed to follow GeoJSON right-hand rule
+        void emit_ring() {
+            if (current_ring.size() < 3) {
+                // Invalid ring, skip it
+                current_ring.clear();
+                return;
+            }
+
+            // Check if ring is closed (first point == last point)
+            // Use epsilon comparison for floating point coordinates
+            const double epsilon = 1e-10;
+            bool is_closed = (current_ring.size() > 3 &&
+                             std::abs(current_ring[0].first - current_ring[current_ring.size()-1].first) < epsilon &&
+                             std::abs(current_ring[0].second - current_ring[current_ring.size()-1].second) < epsilon);
+
+            // Ensure ring is closed for GeoJSON (first point == last point)
+            // GeoJSON spec requires all rings to be closed
+            if (!is_closed && current_ring.size() >= 2) {
+                // Add closing point if not already closed
+                current_ring.push_back(current_ring[0]);
+                is_closed = true;
+            }
+
+            // Check if ring is counter-clockwise using the validation library's formula
+            // sum += (next.x - current.x) * (next.y + current.y)
+            // Counter-clockwise if sum < 0
+            bool is_ccw = is_counter_clockwise(current_ring);
+
+            // All rings must be counter-clockwise according to the validation library
+            // If the ring is not counter-clockwise, reverse it
+            bool should_reverse = !is_ccw;
+
+            // Emit ring
+            callback(user_data, 0, 0, 0); // BEGIN_RING
+
+            if (should_reverse) {
+                // Reverse the ring to fix winding order
+                // For a closed ring [A, B, C, A], we want [A, C, B, A]
+                // We need to reverse all points except keep the first point as both start and end
+                if (is_closed && current_ring.size() > 1) {
+                    // Emit first point (which will be both start and end)
+                    callback(user_data, 1, current_ring[0].first, current_ring[0].second);
+                    // Reverse and emit all points except the first and last (duplicate)
+                    // Go from second-to-last down to second
+                    for (size_t i = current_ring.size() - 2; i >= 1; --i) {
+                        callback(user_data, 1, current_ring[i].first, current_ring[i].second);
+                        if (i == 1) break; // Prevent underflow
+                    }
+                    // Close the ring with first point again
+                    callback(user_data, 1, current_ring[0].first, current_ring[0].second);
+                } else {
+                    // Ring not closed, reverse all points
+                    for (auto it = current_ring.rbegin(); it != current_ring.rend(); ++it) {
+                        callback(user_data, 1, it->first, it->second);
+                    }
                 }
-                // Close the ring with first point again
-                callback(user_data, 1, current_ring[0].first, current_ring[0].second);
             } else {
-                // Ring not closed, reverse all points
-                for (auto it = current_ring.rbegin(); it != current_ring.rend(); ++it) {
-                    callback(user_data, 1, it->first, it->second);
+                // Emit points in original order
+                // GeoJSON requires closed rings, so we always emit all points including closing duplicate
+                for (const auto& point : current_ring) {
+                    callback(user_data, 1, point.first, point.second);
                 }
             }
-        } else {
-            // Emit points in original order
-            // GeoJSON requires closed rings, so we always emit all points including closing duplicate
-            for (const auto& point : current_ring) {
-                callback(user_data, 1, point.first, point.second);
-            }
+
+            callback(user_data, 2, 0, 0); // END_RING
+            current_ring.clear();
         }
-        
-        callback(user_data, 2, 0, 0); // END_RING
-        current_ring.clear();
-    }
 
-    // Point geometry handlers
-    void points_begin(uint32_t /*count*/) {
-        callback(user_data, 0, 0, 0); // BEGIN_RING
-    }
+        // Points and linestrings are emitted as they are decoded
+        void part_begin(uint32_t /*count*/) {
+            callback(user_data, 0, 0, 0); // BEGIN_RING
+        }
 
-    void points_point(const vtzero::point& p) {
-        double lon, lat;
-        project_point(p.x, p.y, lon, lat);
-        callback(user_data, 1, lon, lat); // POINT
-    }
+        void point(double lon, double lat) {
+            callback(user_data, 1, lon, lat); // POINT
+        }
 
-    void points_end() {
-        callback(user_data, 2, 0, 0); // END_RING
-    }
+        void part_end() {
+            callback(user_data, 2, 0, 0); // END_RING
+        }
 
-    // Linestring geometry handlers
-    void linestring_begin(uint32_t /*count*/) {
-        callback(user_data, 0, 0, 0); // BEGIN_RING
-    }
+        void ring_begin(uint32_t /*count*/) {
+            current_ring.clear();
+        }
 
-    void linestring_point(const vtzero::point& p) {
-        double lon, lat;
-        project_point(p.x, p.y, lon, lat);
-        callback(user_data, 1, lon, lat); // POINT
-    }
+        void ring_point(double lon, double lat) {
+            current_ring.push_back(std::make_pair(lon, lat));
+        }
 
-    void linestring_end() {
-        callback(user_data, 2, 0, 0); // END_RING
-    }
+        void ring_end(vtzero::ring_type rt) {
+            // Skip invalid rings (zero area)
+            if (rt == vtzero::ring_type::invalid) {
+                current_ring.clear();
+                return;
+            }
+            emit_ring();
+        }
+    };
 
-    // Polygon ring handlers
-    void ring_begin(uint32_t /*count*/) {
-        is_polygon_ring = true;
-        current_ring.clear();
-    }
+    // vtzero geometry handler that projects each point and forwards it to the sink
+    template <typename Projection, typename Sink>
+    struct ProjectingHandler {
+        const Projection& projection;
+        Sink& sink;
 
-    void ring_point(const vtzero::point& p) {
-        double lon, lat;
-        project_point(p.x, p.y, lon, lat);
-        current_ring.push_back(std::make_pair(lon, lat));
-    }
+        void emit(const vtzero::point& p) {
+            double x, y;
+            projection(p.x, p.y, x, y);
+            sink.point(x, y);
+        }
 
-    void ring_end(vtzero::ring_type rt) {
-        is_polygon_ring = false;
-        // Skip invalid rings (zero area)
-        if (rt == vtzero::ring_type::invalid) {
-            current_ring.clear();
-            return;
+        void points_begin(uint32_t count) {
+            VTZ_STATS_ADD(vertices_emitted, count);
+            sink.part_begin(count);
+        }
+        void points_point(const vtzero::point& p) { emit(p); }
+        void points_end() { sink.part_end(); }
+
+        void linestring_begin(uint32_t count) {
+            VTZ_STATS_ADD(vertices_emitted, count);
+            sink.part_begin(count);
+        }
+        void linestring_point(const vtzero::point& p) { emit(p); }
+        void linestring_end() { sink.part_end(); }
+
+        void ring_begin(uint32_t count) {
+            VTZ_STATS_ADD(vertices_emitted, count);
+            sink.ring_begin(count);
+        }
+        void ring_point(const vtzero::point& p) {
+            double x, y;
+            projection(p.x, p.y, x, y);
+            sink.ring_point(x, y);
         }
-        bool is_outer = (rt == vtzero::ring_type::outer);
-        emit_ring(is_outer);
+        void ring_end(vtzero::ring_type rt) { sink.ring_end(rt); }
+    };
+
+    template <typename Projection, typename Sink>
+    void decode_projected(const vtzero::geometry& geometry, const Projection& projection, Sink& sink) {
+        ProjectingHandler<Projection, Sink> handler{projection, sink};
+        decode_feature_geometry(geometry, handler);
     }
-};
+}
 
 FFI_PLUGIN_EXPORT void vtz_feature_to_geojson(VtzFeatureHandle* feature_handle,
                                                 uint32_t extent,
@@ -778,39 +1885,1613 @@ FFI_PLUGIN_EXPORT void vtz_feature_to_geojson(VtzFeatureHandle* feature_handle,
                                                 uint32_t tile_z,
                                                 GeoJsonCallback callback,
                                                 void* user_data) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_FEATURE_TO_GEOJSON);
+    VTZ_STATS_TIME(VTZ_STATS_LATENCY_GEOJSON);
     if (!feature_handle || !callback) return;
 
     try {
-        auto geometry = feature_handle->feature.geometry();
-        GeoJsonHandler handler(callback, user_data, extent, tile_x, tile_y, tile_z);
+        GeoJsonSink sink(callback, user_data);
+        decode_projected(feature_handle->feature.geometry(),
+                         Wgs84Projection(extent, tile_x, tile_y, tile_z), sink);
+    } catch (...) {
+        // Error during GeoJSON conversion
+    }
+}
+
+FFI_PLUGIN_EXPORT int vtz_feature_decode_projected(VtzFeatureHandle* feature_handle,
+                                                   VtzProjectionKind projection_kind,
+                                                   const VtzProjectionParams* params,
+                                                   VtzProjectedGeometry* out) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_FEATURE_DECODE_PROJECTED);
+    VTZ_STATS_TIME(VTZ_STATS_LATENCY_GEOMETRY_DECODE);
+    clear_exception();
+    if (!feature_handle || !params || !out) return -1;
+
+    out->point_count = 0;
+    out->part_count = 0;
+
+    try {
+        const auto geometry = feature_handle->feature.geometry();
+        ArraySink sink{*out};
 
-        switch (geometry.type()) {
-            case vtzero::GeomType::POINT:
-                vtzero::decode_point_geometry(geometry, handler);
+        // One branch per feature selects the specialized loop
+        switch (projection_kind) {
+            case VTZ_PROJECTION_TILE:
+                decode_projected(geometry, TileProjection(*params), sink);
                 break;
-            case vtzero::GeomType::LINESTRING:
-                vtzero::decode_linestring_geometry(geometry, handler);
+            case VTZ_PROJECTION_WEB_MERCATOR_METERS:
+                decode_projected(geometry, MercatorMetersProjection(*params), sink);
                 break;
-            case vtzero::GeomType::POLYGON:
-                vtzero::decode_polygon_geometry(geometry, handler);
+            case VTZ_PROJECTION_WGS84:
+                decode_projected(geometry, Wgs84Projection(*params), sink);
                 break;
-            default:
-                // Unknown geometry type
+            case VTZ_PROJECTION_SCREEN:
+                decode_projected(geometry, AffineProjection(*params), sink);
                 break;
+            default:
+                set_exception(VTZ_EXCEPTION_GEOMETRY, "unknown projection kind");
+                return -1;
         }
+        return 0;
+    } catch (const vtzero::geometry_exception& e) {
+        set_exception(VTZ_EXCEPTION_GEOMETRY, e.what());
+        return 1;
+    } catch (const std::exception& e) {
+        set_exception(VTZ_EXCEPTION_GEOMETRY, e.what());
+        return -1;
     } catch (...) {
-        // Error during GeoJSON conversion
+        set_exception(VTZ_EXCEPTION_GEOMETRY, "Unknown exception");
+        return -1;
     }
 }
 
-// Exception handling API
-FFI_PLUGIN_EXPORT VtzExceptionType vtz_get_last_exception_type(void) {
-    std::lock_guard<std::mutex> lock(g_exception_mutex);
-    return g_exception_storage.type;
-}
+// Label anchors
+namespace {
+    struct AnchorPoint {
+        double x;
+        double y;
+    };
 
-FFI_PLUGIN_EXPORT const char* vtz_get_last_exception_message(void) {
-    std::lock_guard<std::mutex> lock(g_exception_mutex);
+    // Collects decoded geometry into flat buffers that are reused across features
+    struct AnchorGeometryHandler {
+        struct Part {
+            size_t begin;
+            size_t end;
+            vtzero::ring_type type;
+        };
+
+        std::vector<AnchorPoint> points;
+        std::vector<Part> parts;
+
+        void clear() {
+            points.clear();
+            parts.clear();
+        }
+
+        void begin_part(uint32_t count) {
+            points.reserve(points.size() + count);
+            parts.push_back({points.size(), points.size(), vtzero::ring_type::outer});
+        }
+
+        void add_point(const vtzero::point& p) {
+            points.push_back({static_cast<double>(p.x), static_cast<double>(p.y)});
+        }
+
+        // Each point of a (multi)point is its own part
+        void points_begin(uint32_t count) { points.reserve(points.size() + count); }
+        void points_point(const vtzero::point& p) {
+            parts.push_back({points.size(), points.size() + 1, vtzero::ring_type::outer});
+            add_point(p);
+        }
+        void points_end() {}
+
+        void linestring_begin(uint32_t count) { begin_part(count); }
+        void linestring_point(const vtzero::point& p) { add_point(p); }
+        void linestring_end() { parts.back().end = points.size(); }
+
+        void ring_begin(uint32_t count) { begin_part(count); }
+        void ring_point(const vtzero::point& p) { add_point(p); }
+        void ring_end(vtzero::ring_type rt) {
+            parts.back().end = points.size();
+            parts.back().type = rt;
+        }
+    };
+
+    void decode_anchor_geometry(const vtzero::feature& feature, AnchorGeometryHandler& handler) {
+        handler.clear();
+        decode_feature_geometry(feature.geometry(), handler);
+    }
+
+    VtzLabelAnchor make_anchor(double x, double y, double angle, double weight,
+                               uint32_t feature_index, uint32_t part_index) {
+        VtzLabelAnchor anchor;
+        anchor.x = x;
+        anchor.y = y;
+        anchor.angle = angle;
+        anchor.weight = weight;
+        anchor.feature_index = feature_index;
+        anchor.part_index = part_index;
+        return anchor;
+    }
+
+    AnchorPoint mean_point(const std::vector<AnchorPoint>& points) {
+        AnchorPoint mean{0.0, 0.0};
+        for (const auto& p : points) {
+            mean.x += p.x;
+            mean.y += p.y;
+        }
+        if (!points.empty()) {
+            mean.x /= static_cast<double>(points.size());
+            mean.y /= static_cast<double>(points.size());
+        }
+        return mean;
+    }
+
+    // Twice the signed area of a ring, accumulating the centroid moments
+    double ring_moments(const AnchorPoint* pts, size_t n, double& mx, double& my) {
+        double area2 = 0.0;
+        for (size_t i = 0, j = n - 1; i < n; j = i++) {
+            const double cross = pts[j].x * pts[i].y - pts[i].x * pts[j].y;
+            area2 += cross;
+            mx += (pts[j].x + pts[i].x) * cross;
+            my += (pts[j].y + pts[i].y) * cross;
+        }
+        return area2;
+    }
+
+    // Area-weighted centroid for polygons, length-weighted for linestrings, mean for points
+    VtzLabelAnchor feature_centroid(const vtzero::feature& feature,
+                                    const AnchorGeometryHandler& geom,
+                                    uint32_t feature_index) {
+        const auto& pts = geom.points;
+
+        if (feature.geometry_type() == vtzero::GeomType::POLYGON) {
+            double area2 = 0.0;
+            double mx = 0.0;
+            double my = 0.0;
+            for (const auto& part : geom.parts) {
+                if (part.type == vtzero::ring_type::invalid || part.end - part.begin < 3) continue;
+                // Inner rings have the opposite winding, so their area is subtracted
+                area2 += ring_moments(&pts[part.begin], part.end - part.begin, mx, my);
+            }
+            if (area2 != 0.0) {
+                return make_anchor(mx / (3.0 * area2), my / (3.0 * area2), 0.0,
+                                   std::abs(area2) / 2.0, feature_index, 0);
+            }
+        } else if (feature.geometry_type() == vtzero::GeomType::LINESTRING) {
+            double length = 0.0;
+            double mx = 0.0;
+            double my = 0.0;
+            for (const auto& part : geom.parts) {
+                for (size_t i = part.begin + 1; i < part.end; ++i) {
+                    const double segment = std::hypot(pts[i].x - pts[i - 1].x, pts[i].y - pts[i - 1].y);
+                    length += segment;
+                    mx += (pts[i].x + pts[i - 1].x) * 0.5 * segment;
+                    my += (pts[i].y + pts[i - 1].y) * 0.5 * segment;
+                }
+            }
+            if (length > 0.0) {
+                return make_anchor(mx / length, my / length, 0.0, length, feature_index, 0);
+            }
+        }
+
+        // Points, or degenerate lines and polygons
+        const auto mean = mean_point(pts);
+        return make_anchor(mean.x, mean.y, 0.0, static_cast<double>(pts.size()), feature_index, 0);
+    }
+
+    // count anchors per linestring part, centered in equal-length sections, with tangent angles.
+    // A count of one gives the length-weighted midpoint.
+    void line_anchors(const AnchorGeometryHandler& geom,
+                      uint32_t count,
+                      uint32_t feature_index,
+                      std::vector<VtzLabelAnchor>& out) {
+        const auto& pts = geom.points;
+        if (count == 0) count = 1;
+
+        uint32_t part_index = 0;
+        for (const auto& part : geom.parts) {
+            const uint32_t index = part_index++;
+            if (part.end == part.begin) continue;
+
+            double length = 0.0;
+            for (size_t i = part.begin + 1; i < part.end; ++i) {
+                length += std::hypot(pts[i].x - pts[i - 1].x, pts[i].y - pts[i - 1].y);
+            }
+
+            if (length == 0.0) {
+                out.push_back(make_anchor(pts[part.begin].x, pts[part.begin].y, 0.0, 0.0, feature_index, index));
+                continue;
+            }
+
+            // Targets are increasing, so a single pass over the segments covers all anchors
+            size_t segment = part.begin + 1;
+            double walked = 0.0;
+            double segment_length = std::hypot(pts[segment].x - pts[segment - 1].x,
+                                               pts[segment].y - pts[segment - 1].y);
+            for (uint32_t k = 0; k < count; ++k) {
+                const double target = length * (k + 0.5) / count;
+                while (walked + segment_length < target && segment + 1 < part.end) {
+                    walked += segment_length;
+                    ++segment;
+                    segment_length = std::hypot(pts[segment].x - pts[segment - 1].x,
+                                                pts[segment].y - pts[segment - 1].y);
+                }
+
+                const auto& a = pts[segment - 1];
+                const auto& b = pts[segment];
+                const double t = segment_length > 0.0 ? std::min(1.0, (target - walked) / segment_length) : 0.0;
+                out.push_back(make_anchor(a.x + (b.x - a.x) * t,
+                                          a.y + (b.y - a.y) * t,
+                                          std::atan2(b.y - a.y, b.x - a.x),
+                                          length,
+                                          feature_index,
+                                          index));
+            }
+        }
+    }
+
+    double segment_distance_sq(double px, double py, const AnchorPoint& a, const AnchorPoint& b) {
+        double x = a.x;
+        double y = a.y;
+        double dx = b.x - x;
+        double dy = b.y - y;
+
+        if (dx != 0.0 || dy != 0.0) {
+            const double t = ((px - x) * dx + (py - y) * dy) / (dx * dx + dy * dy);
+            if (t > 1.0) {
+                x = b.x;
+                y = b.y;
+            } else if (t > 0.0) {
+                x += dx * t;
+                y += dy * t;
+            }
+        }
+
+        dx = px - x;
+        dy = py - y;
+        return dx * dx + dy * dy;
+    }
+
+    // Signed distance from a point to the polygon outline, negative outside
+    double polygon_distance(double px, double py,
+                            const std::vector<AnchorPoint>& pts,
+                            const std::vector<AnchorGeometryHandler::Part>& rings) {
+        bool inside = false;
+        double min_sq = std::numeric_limits<double>::infinity();
+
+        for (const auto& ring : rings) {
+            for (size_t i = ring.begin, j = ring.end - 1; i < ring.end; j = i++) {
+                const auto& a = pts[i];
+                const auto& b = pts[j];
+                if ((a.y > py) != (b.y > py) &&
+                    px < (b.x - a.x) * (py - a.y) / (b.y - a.y) + a.x) {
+                    inside = !inside;
+                }
+                min_sq = std::min(min_sq, segment_distance_sq(px, py, a, b));
+            }
+        }
+
+        return (inside ? 1.0 : -1.0) * std::sqrt(min_sq);
+    }
+
+    struct PolylabelCell {
+        double x;
+        double y;
+        double h;    // Half the cell size
+        double d;    // Distance from the cell center to the polygon
+        double max;  // Upper bound of the distance within the cell
+
+        PolylabelCell(double cx, double cy, double half,
+                      const std::vector<AnchorPoint>& pts,
+                      const std::vector<AnchorGeometryHandler::Part>& rings)
+            : x(cx), y(cy), h(half), d(polygon_distance(cx, cy, pts, rings)), max(d + half * std::sqrt(2.0)) {}
+
+        bool operator<(const PolylabelCell& other) const { return max < other.max; }
+    };
+
+    // Pole of inaccessibility by iterative grid refinement (Mapbox polylabel).
+    // rings[0] is the outer ring, the remaining ones are holes.
+    PolylabelCell polylabel(const std::vector<AnchorPoint>& pts,
+                            const std::vector<AnchorGeometryHandler::Part>& rings,
+                            double precision) {
+        const auto& outer = rings.front();
+        double min_x = pts[outer.begin].x;
+        double min_y = pts[outer.begin].y;
+        double max_x = min_x;
+        double max_y = min_y;
+        for (size_t i = outer.begin; i < outer.end; ++i) {
+            min_x = std::min(min_x, pts[i].x);
+            min_y = std::min(min_y, pts[i].y);
+            max_x = std::max(max_x, pts[i].x);
+            max_y = std::max(max_y, pts[i].y);
+        }
+
+        const double width = max_x - min_x;
+        const double height = max_y - min_y;
+        const double cell_size = std::min(width, height);
+        if (cell_size == 0.0) {
+            return PolylabelCell(min_x, min_y, 0.0, pts, rings);
+        }
+        if (precision <= 0.0) precision = 1.0;
+
+        std::priority_queue<PolylabelCell> queue;
+        const double h = cell_size / 2.0;
+        for (double x = min_x; x < max_x; x += cell_size) {
+            for (double y = min_y; y < max_y; y += cell_size) {
+                queue.emplace(x + h, y + h, h, pts, rings);
+            }
+        }
+
+        // Start from the centroid, or the bounding box center if that is further inside
+        double mx = 0.0;
+        double my = 0.0;
+        const double area2 = ring_moments(&pts[outer.begin], outer.end - outer.begin, mx, my);
+        PolylabelCell best = area2 != 0.0
+            ? PolylabelCell(mx / (3.0 * area2), my / (3.0 * area2), 0.0, pts, rings)
+            : PolylabelCell(pts[outer.begin].x, pts[outer.begin].y, 0.0, pts, rings);
+
+        PolylabelCell bbox_cell(min_x + width / 2.0, min_y + height / 2.0, 0.0, pts, rings);
+        if (bbox_cell.d > best.d) best = bbox_cell;
+
+        while (!queue.empty()) {
+            const PolylabelCell cell = queue.top();
+            queue.pop();
+
+            if (cell.d > best.d) best = cell;
+
+            // Do not drill down further if there is no chance of a better solution
+            if (cell.max - best.d <= precision) continue;
+
+            const double half = cell.h / 2.0;
+            queue.emplace(cell.x - half, cell.y - half, half, pts, rings);
+            queue.emplace(cell.x + half, cell.y - half, half, pts, rings);
+            queue.emplace(cell.x - half, cell.y + half, half, pts, rings);
+            queue.emplace(cell.x + half, cell.y + half, half, pts, rings);
+        }
+
+        return best;
+    }
+
+    // One pole of inaccessibility per polygon (outer ring with its holes)
+    void polylabel_anchors(const AnchorGeometryHandler& geom,
+                           double precision,
+                           uint32_t feature_index,
+                           std::vector<VtzLabelAnchor>& out) {
+        std::vector<AnchorGeometryHandler::Part> rings;
+        uint32_t polygon_index = 0;
+
+        auto flush = [&]() {
+            if (rings.empty()) return;
+            const auto best = polylabel(geom.points, rings, precision);
+            out.push_back(make_anchor(best.x, best.y, 0.0, std::max(0.0, best.d), feature_index, polygon_index++));
+            rings.clear();
+        };
+
+        for (const auto& part : geom.parts) {
+            if (part.type == vtzero::ring_type::invalid || part.end - part.begin < 3) continue;
+            if (part.type == vtzero::ring_type::outer) {
+                flush();
+            } else if (rings.empty()) {
+                continue;  // Hole without an outer ring
+            }
+            rings.push_back(part);
+        }
+        flush();
+    }
+
+    // Anchors of a single feature, features of the wrong geometry type produce none
+    void feature_label_anchors(const vtzero::feature& feature,
+                               VtzLabelAnchorKind kind,
+                               double precision,
+                               uint32_t count,
+                               uint32_t feature_index,
+                               AnchorGeometryHandler& geom,
+                               std::vector<VtzLabelAnchor>& out) {
+        switch (kind) {
+            case VTZ_LABEL_ANCHOR_POLYLABEL:
+                if (feature.geometry_type() != vtzero::GeomType::POLYGON) return;
+                decode_anchor_geometry(feature, geom);
+                polylabel_anchors(geom, precision, feature_index, out);
+                break;
+            case VTZ_LABEL_ANCHOR_CENTROID:
+                decode_anchor_geometry(feature, geom);
+                if (!geom.points.empty()) {
+                    out.push_back(feature_centroid(feature, geom, feature_index));
+                }
+                break;
+            case VTZ_LABEL_ANCHOR_LINE:
+                if (feature.geometry_type() != vtzero::GeomType::LINESTRING) return;
+                decode_anchor_geometry(feature, geom);
+                line_anchors(geom, count, feature_index, out);
+                break;
+        }
+    }
+
+    bool valid_label_anchor_kind(VtzLabelAnchorKind kind) {
+        switch (kind) {
+            case VTZ_LABEL_ANCHOR_POLYLABEL:
+            case VTZ_LABEL_ANCHOR_CENTROID:
+            case VTZ_LABEL_ANCHOR_LINE:
+                return true;
+            default:
+                return false;
+        }
+    }
+}
+
+struct VtzLabelAnchorsHandle {
+    std::vector<VtzLabelAnchor> anchors;
+};
+
+FFI_PLUGIN_EXPORT VtzLabelAnchorsHandle* vtz_feature_label_anchors(VtzFeatureHandle* feature_handle,
+                                                                    VtzLabelAnchorKind kind,
+                                                                    double precision,
+                                                                    uint32_t count) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_FEATURE_LABEL_ANCHORS);
+    clear_exception();
+    if (!feature_handle) return nullptr;
+    if (!valid_label_anchor_kind(kind)) {
+        set_exception(VTZ_EXCEPTION_GEOMETRY, "unknown label anchor kind");
+        return nullptr;
+    }
+
+    try {
+        std::unique_ptr<VtzLabelAnchorsHandle> result(new VtzLabelAnchorsHandle());
+        AnchorGeometryHandler geom;
+        feature_label_anchors(feature_handle->feature, kind, precision, count, 0, geom, result->anchors);
+        return result.release();
+    } catch (const vtzero::geometry_exception& e) {
+        set_exception(VTZ_EXCEPTION_GEOMETRY, e.what());
+        return nullptr;
+    } catch (const std::exception& e) {
+        set_exception(VTZ_EXCEPTION_GEOMETRY, e.what());
+        return nullptr;
+    } catch (...) {
+        set_exception(VTZ_EXCEPTION_GEOMETRY, "Unknown exception");
+        return nullptr;
+    }
+}
+
+FFI_PLUGIN_EXPORT VtzLabelAnchorsHandle* vtz_layer_label_anchors(VtzLayerHandle* layer_handle,
+                                                                  VtzLabelAnchorKind kind,
+                                                                  double precision,
+                                                                  uint32_t count) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_LAYER_LABEL_ANCHORS);
+    clear_exception();
+    if (!layer_handle) return nullptr;
+    if (!valid_label_anchor_kind(kind)) {
+        set_exception(VTZ_EXCEPTION_GEOMETRY, "unknown label anchor kind");
+        return nullptr;
+    }
+
+    try {
+        std::unique_ptr<VtzLabelAnchorsHandle> result(new VtzLabelAnchorsHandle());
+        AnchorGeometryHandler geom;
+        uint32_t feature_index = 0;
+
+        for_each_layer_feature(layer_handle->layer, [&](const vtzero::feature& feature) {
+            const uint32_t index = feature_index++;
+            try {
+                feature_label_anchors(feature, kind, precision, count, index, geom, result->anchors);
+            } catch (const vtzero::geometry_exception&) {
+                // Features with invalid geometry get no anchors
+            } catch (const protozero::exception&) {
+                // Truncated geometry data
+            }
+        });
+
+        return result.release();
+    } catch (const vtzero::format_exception& e) {
+        set_exception(VTZ_EXCEPTION_FORMAT, e.what());
+        return nullptr;
+    } catch (const std::exception& e) {
+        set_exception(VTZ_EXCEPTION_FORMAT, e.what());
+        return nullptr;
+    } catch (...) {
+        set_exception(VTZ_EXCEPTION_FORMAT, "Unknown exception");
+        return nullptr;
+    }
+}
+
+FFI_PLUGIN_EXPORT size_t vtz_label_anchors_count(VtzLabelAnchorsHandle* anchors_handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_LABEL_ANCHORS_COUNT);
+    if (!anchors_handle) return 0;
+    return anchors_handle->anchors.size();
+}
+
+FFI_PLUGIN_EXPORT const VtzLabelAnchor* vtz_label_anchors_data(VtzLabelAnchorsHandle* anchors_handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_LABEL_ANCHORS_DATA);
+    if (!anchors_handle || anchors_handle->anchors.empty()) return nullptr;
+    return anchors_handle->anchors.data();
+}
+
+FFI_PLUGIN_EXPORT void vtz_label_anchors_free(VtzLabelAnchorsHandle* anchors_handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_LABEL_ANCHORS_FREE);
+    delete anchors_handle;
+}
+
+// Cross-tile line merging
+namespace {
+    struct MergePoint {
+        double x;
+        double y;
+    };
+
+    // A clipped linestring piece in world coordinates
+    struct MergePiece {
+        std::vector<MergePoint> points;
+        uint32_t group;      // Interned merge key, pieces only join within a group
+        bool start_on_seam;  // Endpoint lies on the tile boundary
+        bool end_on_seam;
+    };
+
+    // Normalized merge key: a type tag followed by the value, so equal values
+    // encoded with different integer types still match
+    bool property_merge_key(const vtzero::feature& feature, const std::string& property, std::string& key) {
+        bool found = false;
+        feature.for_each_property([&](const vtzero::property& prop) {
+            const auto key_view = prop.key();
+            if (key_view.size() != property.size() ||
+                std::memcmp(key_view.data(), property.data(), property.size()) != 0) {
+                return true;
+            }
+
+            const auto value = prop.value();
+            char buffer[32];
+            switch (value.type()) {
+                case vtzero::property_value_type::string_value: {
+                    const auto view = value.string_value();
+                    key = "s" + std::string(view.data(), view.size());
+                    break;
+                }
+                case vtzero::property_value_type::float_value:
+                case vtzero::property_value_type::double_value: {
+                    const double number = value.type() == vtzero::property_value_type::float_value
+                        ? static_cast<double>(value.float_value())
+                        : value.double_value();
+                    if (number == std::floor(number) && std::abs(number) < 9.0e15) {
+                        snprintf(buffer, sizeof(buffer), "i%lld", static_cast<long long>(number));
+                    } else {
+                        snprintf(buffer, sizeof(buffer), "d%.17g", number);
+                    }
+                    key = buffer;
+                    break;
+                }
+                case vtzero::property_value_type::int_value:
+                    snprintf(buffer, sizeof(buffer), "i%lld", static_cast<long long>(value.int_value()));
+                    key = buffer;
+                    break;
+                case vtzero::property_value_type::sint_value:
+                    snprintf(buffer, sizeof(buffer), "i%lld", static_cast<long long>(value.sint_value()));
+                    key = buffer;
+                    break;
+                case vtzero::property_value_type::uint_value:
+                    snprintf(buffer, sizeof(buffer), "i%llu", static_cast<unsigned long long>(value.uint_value()));
+                    key = buffer;
+                    break;
+                case vtzero::property_value_type::bool_value:
+                    key = value.bool_value() ? "btrue" : "bfalse";
+                    break;
+            }
+            found = true;
+            return false;
+        });
+        return found;
+    }
+
+    // Collects the parts of a linestring feature in tile coordinates
+    struct LinePartsHandler {
+        std::vector<std::vector<MergePoint>> parts;
+
+        void linestring_begin(uint32_t count) {
+            parts.emplace_back();
+            parts.back().reserve(count);
+        }
+
+        void linestring_point(const vtzero::point& p) {
+            parts.back().push_back({static_cast<double>(p.x), static_cast<double>(p.y)});
+        }
+
+        void linestring_end() {}
+    };
+
+    // Liang-Barsky clip of segment a-b to [0, extent]^2; clipped ends are snapped onto the boundary
+    bool clip_segment(MergePoint& a, MergePoint& b, double extent) {
+        const double dx = b.x - a.x;
+        const double dy = b.y - a.y;
+        double t0 = 0.0;
+        double t1 = 1.0;
+
+        const double p[4] = {-dx, dx, -dy, dy};
+        const double q[4] = {a.x, extent - a.x, a.y, extent - a.y};
+        for (int i = 0; i < 4; ++i) {
+            if (p[i] == 0.0) {
+                if (q[i] < 0.0) return false;
+                continue;
+            }
+            const double t = q[i] / p[i];
+            if (p[i] < 0.0) {
+                if (t > t1) return false;
+                if (t > t0) t0 = t;
+            } else {
+                if (t < t0) return false;
+                if (t < t1) t1 = t;
+            }
+        }
+
+        const MergePoint start = a;
+        auto snap = [extent](double v) {
+            return std::min(extent, std::max(0.0, v));
+        };
+        if (t0 > 0.0) {
+            a = {snap(start.x + t0 * dx), snap(start.y + t0 * dy)};
+        }
+        if (t1 < 1.0) {
+            b = {snap(start.x + t1 * dx), snap(start.y + t1 * dy)};
+        }
+        return true;
+    }
+
+    bool on_tile_edge(const MergePoint& p, double extent) {
+        return p.x <= 0.0 || p.y <= 0.0 || p.x >= extent || p.y >= extent;
+    }
+
+    struct MergeCell {
+        uint32_t group;
+        int64_t x;
+        int64_t y;
+
+        bool operator==(const MergeCell& other) const {
+            return group == other.group && x == other.x && y == other.y;
+        }
+    };
+
+    struct MergeCellHash {
+        size_t operator()(const MergeCell& cell) const {
+            uint64_t h = cell.group;
+            h = h * 0x9e3779b97f4a7c15ULL ^ static_cast<uint64_t>(cell.x);
+            h = h * 0x9e3779b97f4a7c15ULL ^ static_cast<uint64_t>(cell.y);
+            h ^= h >> 31;
+            return static_cast<size_t>(h * 0xbf58476d1ce4e5b9ULL);
+        }
+    };
+
+    // Greedily chains pieces whose seam endpoints coincide within tolerance.
+    // Endpoints are hashed into a grid of tolerance-sized cells, so each join
+    // is a constant number of probes.
+    class LineMerger {
+    public:
+        LineMerger(std::vector<MergePiece>& pieces, double tolerance)
+            : pieces_(pieces),
+              tolerance_sq_(tolerance * tolerance),
+              cell_size_(std::max(tolerance, 1e-6)),
+              used_(pieces.size(), false) {
+            for (uint32_t i = 0; i < pieces_.size(); ++i) {
+                const auto& piece = pieces_[i];
+                if (piece.start_on_seam) add(piece.points.front(), piece.group, i * 2);
+                if (piece.end_on_seam) add(piece.points.back(), piece.group, i * 2 + 1);
+            }
+        }
+
+        // Chains starting at piece `first`; returns the number of joined pieces
+        uint32_t chain(uint32_t first, std::vector<MergePoint>& line) {
+            used_[first] = true;
+            const auto& piece = pieces_[first];
+            line = piece.points;
+            uint32_t joined = 1;
+
+            bool tail_on_seam = piece.end_on_seam;
+            joined += extend(line, piece.group, tail_on_seam);
+
+            if (piece.start_on_seam) {
+                std::reverse(line.begin(), line.end());
+                bool head_on_seam = true;
+                joined += extend(line, piece.group, head_on_seam);
+                std::reverse(line.begin(), line.end());
+            }
+            return joined;
+        }
+
+        bool used(uint32_t piece) const { return used_[piece]; }
+
+    private:
+        MergeCell cell(const MergePoint& p, uint32_t group, int64_t dx, int64_t dy) const {
+            return {group,
+                    static_cast<int64_t>(std::floor(p.x / cell_size_)) + dx,
+                    static_cast<int64_t>(std::floor(p.y / cell_size_)) + dy};
+        }
+
+        void add(const MergePoint& p, uint32_t group, uint32_t endpoint) {
+            endpoints_[cell(p, group, 0, 0)].push_back(endpoint);
+        }
+
+        // Appends matching pieces to the end of the line while its tail is on a seam
+        uint32_t extend(std::vector<MergePoint>& line, uint32_t group, bool tail_on_seam) {
+            uint32_t joined = 0;
+            while (tail_on_seam) {
+                const uint32_t endpoint = find(line.back(), group);
+                if (endpoint == kNone) break;
+
+                const uint32_t index = endpoint / 2;
+                const auto& next = pieces_[index];
+                used_[index] = true;
+                ++joined;
+
+                if (endpoint % 2 == 0) {
+                    // Matched the start of the next piece
+                    line.insert(line.end(), next.points.begin() + 1, next.points.end());
+                    tail_on_seam = next.end_on_seam;
+                } else {
+                    line.insert(line.end(), next.points.rbegin() + 1, next.points.rend());
+                    tail_on_seam = next.start_on_seam;
+                }
+            }
+            return joined;
+        }
+
+        uint32_t find(const MergePoint& p, uint32_t group) const {
+            for (int64_t dx = -1; dx <= 1; ++dx) {
+                for (int64_t dy = -1; dy <= 1; ++dy) {
+                    auto it = endpoints_.find(cell(p, group, dx, dy));
+                    if (it == endpoints_.end()) continue;
+
+                    for (uint32_t endpoint : it->second) {
+                        const auto& piece = pieces_[endpoint / 2];
+                        if (used_[endpoint / 2]) continue;
+
+                        const auto& q = endpoint % 2 == 0 ? piece.points.front() : piece.points.back();
+                        const double ex = q.x - p.x;
+                        const double ey = q.y - p.y;
+                        if (ex * ex + ey * ey <= tolerance_sq_) return endpoint;
+                    }
+                }
+            }
+            return kNone;
+        }
+
+        static constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max();
+
+        std::vector<MergePiece>& pieces_;
+        double tolerance_sq_;
+        double cell_size_;
+        std::vector<bool> used_;
+        std::unordered_map<MergeCell, std::vector<uint32_t>, MergeCellHash> endpoints_;
+    };
+
+    constexpr uint32_t LineMerger::kNone;
+}
+
+struct VtzMergedLinesHandle {
+    std::vector<double> coordinates;  // x, y pairs in world coordinates
+    std::vector<uint32_t> offsets;    // Point offset of each line, plus the total at the end
+    std::vector<uint32_t> piece_counts;
+    std::vector<std::string> keys;    // Key of each line's group
+    double world_size = 0.0;
+};
+
+FFI_PLUGIN_EXPORT VtzMergedLinesHandle* vtz_merge_lines(const VtzMergeTile* tiles,
+                                                        size_t tile_count,
+                                                        const char* layer_name,
+                                                        VtzMergeKeyKind key_kind,
+                                                        const char* property_key,
+                                                        double tolerance) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_MERGE_LINES);
+    clear_exception();
+    if (!tiles || !layer_name) return nullptr;
+    switch (key_kind) {
+        case VTZ_MERGE_KEY_LAYER:
+        case VTZ_MERGE_KEY_FEATURE_ID:
+            break;
+        case VTZ_MERGE_KEY_PROPERTY:
+            if (!property_key) return nullptr;
+            break;
+        default:
+            set_exception(VTZ_EXCEPTION_OUT_OF_RANGE, "unknown merge key kind");
+            return nullptr;
+    }
+
+    try {
+        // Shared coordinate space: the deepest zoom and largest extent among the inputs
+        uint32_t max_zoom = 0;
+        for (size_t i = 0; i < tile_count; ++i) {
+            max_zoom = std::max(max_zoom, tiles[i].z);
+        }
+
+        struct SourceLayer {
+            vtzero::layer layer;
+            const VtzMergeTile* tile;
+        };
+        std::vector<SourceLayer> layers;
+        double world_extent = 0.0;
+        for (size_t i = 0; i < tile_count; ++i) {
+            if (!tiles[i].tile) continue;
+            auto layer = tiles[i].tile->tile.get_layer_by_name(layer_name);
+            if (!layer) continue;
+            world_extent = std::max(world_extent, static_cast<double>(layer.extent()));
+            layers.push_back({std::move(layer), &tiles[i]});
+        }
+
+        std::unique_ptr<VtzMergedLinesHandle> result(new VtzMergedLinesHandle());
+        result->world_size = world_extent * std::ldexp(1.0, static_cast<int>(max_zoom));
+        result->offsets.push_back(0);
+
+        const std::string property = property_key ? property_key : "";
+        std::unordered_map<std::string, uint32_t> groups;
+        std::vector<std::string> group_keys;
+        std::vector<MergePiece> pieces;
+        std::vector<MergePiece> unkeyed;  // Lines without a key are passed through unmerged
+
+        std::string key;
+        for (auto& source : layers) {
+            const double extent = static_cast<double>(source.layer.extent());
+            const double scale = std::ldexp(1.0, static_cast<int>(max_zoom - source.tile->z)) * world_extent;
+            const double origin_x = source.tile->x * scale;
+            const double origin_y = source.tile->y * scale;
+            const double unit = scale / extent;
+
+            for_each_layer_feature(source.layer, [&](const vtzero::feature& feature) {
+                if (feature.geometry_type() != vtzero::GeomType::LINESTRING) return;
+
+                // Features with invalid geometry are skipped instead of failing the merge
+                LinePartsHandler handler;
+                try {
+                    GeometryCommandDecoder{feature.geometry()}.decode_linestring(handler);
+                } catch (const vtzero::geometry_exception&) {
+                    return;
+                } catch (const protozero::exception&) {
+                    return;  // Truncated geometry data
+                }
+
+                bool keyed = true;
+                switch (key_kind) {
+                    case VTZ_MERGE_KEY_LAYER:
+                        key.clear();
+                        break;
+                    case VTZ_MERGE_KEY_PROPERTY:
+                        keyed = property_merge_key(feature, property, key);
+                        break;
+                    case VTZ_MERGE_KEY_FEATURE_ID:
+                        keyed = feature.has_id();
+                        key = keyed ? "i" + std::to_string(feature.id()) : std::string();
+                        break;
+                }
+
+                uint32_t group = 0;
+                if (keyed) {
+                    auto inserted = groups.emplace(key, static_cast<uint32_t>(group_keys.size()));
+                    if (inserted.second) group_keys.push_back(key);
+                    group = inserted.first->second;
+                }
+
+                // Clip each part to the tile, the buffer overlaps the neighbouring tiles
+                for (const auto& part : handler.parts) {
+                    MergePiece piece{{}, group, false, false};
+                    auto flush = [&]() {
+                        if (piece.points.size() >= 2) {
+                            piece.start_on_seam = piece.start_on_seam && keyed;
+                            piece.end_on_seam = on_tile_edge(piece.points.back(), extent) && keyed;
+                            for (auto& p : piece.points) {
+                                p = {origin_x + p.x * unit, origin_y + p.y * unit};
+                            }
+                            (keyed ? pieces : unkeyed).push_back(std::move(piece));
+                        }
+                        piece = MergePiece{{}, group, false, false};
+                    };
+
+                    for (size_t i = 1; i < part.size(); ++i) {
+                        MergePoint a = part[i - 1];
+                        MergePoint b = part[i];
+                        if (!clip_segment(a, b, extent)) {
+                            flush();
+                            continue;
+                        }
+                        if (piece.points.empty()) {
+                            piece.points.push_back(a);
+                            piece.start_on_seam = on_tile_edge(a, extent);
+                        }
+                        piece.points.push_back(b);
+                        if (b.x != part[i].x || b.y != part[i].y) {
+                            flush();  // Left the tile
+                        }
+                    }
+                    flush();
+                }
+            });
+        }
+
+        auto emit = [&](const std::vector<MergePoint>& line, uint32_t piece_count, const std::string& line_key) {
+            for (const auto& p : line) {
+                result->coordinates.push_back(p.x);
+                result->coordinates.push_back(p.y);
+            }
+            result->offsets.push_back(static_cast<uint32_t>(result->coordinates.size() / 2));
+            result->piece_counts.push_back(piece_count);
+            // Strip the type tag
+            result->keys.push_back(line_key.empty() ? line_key : line_key.substr(1));
+        };
+
+        LineMerger merger(pieces, tolerance);
+        std::vector<MergePoint> line;
+        for (uint32_t i = 0; i < pieces.size(); ++i) {
+            if (merger.used(i)) continue;
+            const uint32_t piece_count = merger.chain(i, line);
+            emit(line, piece_count, group_keys[pieces[i].group]);
+        }
+        for (const auto& piece : unkeyed) {
+            emit(piece.points, 1, std::string());
+        }
+
+        return result.release();
+    } catch (const vtzero::geometry_exception& e) {
+        set_exception(VTZ_EXCEPTION_GEOMETRY, e.what());
+        return nullptr;
+    } catch (const vtzero::format_exception& e) {
+        set_exception(VTZ_EXCEPTION_FORMAT, e.what());
+        return nullptr;
+    } catch (const std::exception& e) {
+        set_exception(VTZ_EXCEPTION_FORMAT, e.what());
+        return nullptr;
+    } catch (...) {
+        set_exception(VTZ_EXCEPTION_FORMAT, "Unknown exception");
+        return nullptr;
+    }
+}
+
+FFI_PLUGIN_EXPORT size_t vtz_merged_lines_count(VtzMergedLinesHandle* lines_handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_MERGED_LINES_COUNT);
+    if (!lines_handle) return 0;
+    return lines_handle->piece_counts.size();
+}
+
+FFI_PLUGIN_EXPORT const double* vtz_merged_lines_coordinates(VtzMergedLinesHandle* lines_handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_MERGED_LINES_COORDINATES);
+    if (!lines_handle || lines_handle->coordinates.empty()) return nullptr;
+    return lines_handle->coordinates.data();
+}
+
+FFI_PLUGIN_EXPORT const uint32_t* vtz_merged_lines_offsets(VtzMergedLinesHandle* lines_handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_MERGED_LINES_OFFSETS);
+    if (!lines_handle) return nullptr;
+    return lines_handle->offsets.data();
+}
+
+FFI_PLUGIN_EXPORT uint32_t vtz_merged_lines_piece_count(VtzMergedLinesHandle* lines_handle, size_t index) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_MERGED_LINES_PIECE_COUNT);
+    if (!lines_handle || index >= lines_handle->piece_counts.size()) return 0;
+    return lines_handle->piece_counts[index];
+}
+
+FFI_PLUGIN_EXPORT const char* vtz_merged_lines_key(VtzMergedLinesHandle* lines_handle, size_t index) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_MERGED_LINES_KEY);
+    if (!lines_handle || index >= lines_handle->keys.size()) return nullptr;
+    return lines_handle->keys[index].c_str();
+}
+
+FFI_PLUGIN_EXPORT double vtz_merged_lines_world_size(VtzMergedLinesHandle* lines_handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_MERGED_LINES_WORLD_SIZE);
+    if (!lines_handle) return 0.0;
+    return lines_handle->world_size;
+}
+
+FFI_PLUGIN_EXPORT void vtz_merged_lines_free(VtzMergedLinesHandle* lines_handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_MERGED_LINES_FREE);
+    delete lines_handle;
+}
+
+// Compact geometry store
+namespace {
+    // Zigzag on wrapping 32 bit deltas, so any pair of int32 coordinates round-trips
+    inline uint32_t zigzag_encode(uint32_t delta) noexcept {
+        return (delta << 1U) ^ static_cast<uint32_t>(static_cast<int32_t>(delta) >> 31U);
+    }
+
+    inline uint32_t zigzag_decode(uint32_t value) noexcept {
+        return (value >> 1U) ^ (0U - (value & 1U));
+    }
+
+    // Collects the parts of one feature, reused across features. Empty parts are
+    // dropped like in VtzFeature.decodeGeometry.
+    struct StoreGeometryHandler {
+        std::vector<vtzero::point> points;
+        std::vector<uint32_t> part_offsets;
+
+        void clear() {
+            points.clear();
+            part_offsets.clear();
+        }
+
+        void begin_part(uint32_t count) {
+            points.reserve(points.size() + count);
+            part_offsets.push_back(static_cast<uint32_t>(points.size()));
+        }
+
+        void end_part() {
+            if (part_offsets.back() == points.size()) part_offsets.pop_back();
+        }
+
+        void points_begin(uint32_t count) { begin_part(count); }
+        void points_point(const vtzero::point& p) { points.push_back(p); }
+        void points_end() { end_part(); }
+
+        void linestring_begin(uint32_t count) { begin_part(count); }
+        void linestring_point(const vtzero::point& p) { points.push_back(p); }
+        void linestring_end() { end_part(); }
+
+        void ring_begin(uint32_t count) { begin_part(count); }
+        void ring_point(const vtzero::point& p) { points.push_back(p); }
+        void ring_end(vtzero::ring_type) { end_part(); }
+    };
+}
+
+struct VtzGeometryStoreHandle {
+    struct Layer {
+        std::string name;
+        uint32_t extent;
+        uint32_t first_feature;
+        uint32_t feature_count;
+    };
+
+    struct Feature {
+        uint32_t value_offset;  // First zigzag value in narrow or wide
+        uint32_t first_part;    // First entry in part_offsets
+        uint32_t part_count;
+        uint32_t point_count;
+        uint32_t layer_index;
+        uint8_t geometry_type;
+        bool wide;              // Deltas need 32 bits
+    };
+
+    std::vector<Layer> layers;
+    std::vector<Feature> features;
+    std::vector<uint32_t> part_offsets;  // Point offset of each part within its feature
+    std::vector<uint16_t> narrow;        // x, y zigzag deltas, restarting from 0, 0 at each part
+    std::vector<uint32_t> wide;
+
+    uint32_t part_end(const Feature& feature, uint32_t part) const {
+        return part + 1 < feature.part_count ? part_offsets[feature.first_part + part + 1]
+                                             : feature.point_count;
+    }
+
+    // Calls emit(x, y) for every point of parts [part_begin, part_end)
+    template <typename F>
+    size_t decode(const Feature& feature, uint32_t part_begin, uint32_t part_end_index, F&& emit) const {
+        part_end_index = std::min(part_end_index, feature.part_count);
+        if (part_begin >= part_end_index) return 0;
+        return feature.wide ? decode_values(wide.data(), feature, part_begin, part_end_index, emit)
+                            : decode_values(narrow.data(), feature, part_begin, part_end_index, emit);
+    }
+
+    void shrink_to_fit() {
+        layers.shrink_to_fit();
+        features.shrink_to_fit();
+        part_offsets.shrink_to_fit();
+        narrow.shrink_to_fit();
+        wide.shrink_to_fit();
+    }
+
+    size_t byte_size() const {
+        size_t bytes = sizeof(*this) + layers.capacity() * sizeof(Layer) +
+                       features.capacity() * sizeof(Feature) +
+                       part_offsets.capacity() * sizeof(uint32_t) +
+                       narrow.capacity() * sizeof(uint16_t) + wide.capacity() * sizeof(uint32_t);
+        for (const auto& layer : layers) {
+            bytes += layer.name.capacity();
+        }
+        return bytes;
+    }
+
+private:
+    template <typename T, typename F>
+    size_t decode_values(const T* values, const Feature& feature, uint32_t part_begin,
+                         uint32_t part_end_index, F& emit) const {
+        size_t count = 0;
+        for (uint32_t part = part_begin; part < part_end_index; ++part) {
+            const uint32_t begin = part_offsets[feature.first_part + part];
+            const uint32_t end = part_end(feature, part);
+            const T* value = values + feature.value_offset + 2 * static_cast<size_t>(begin);
+            uint32_t x = 0;
+            uint32_t y = 0;
+            for (uint32_t i = begin; i < end; ++i, value += 2) {
+                x += zigzag_decode(value[0]);
+                y += zigzag_decode(value[1]);
+                emit(static_cast<int32_t>(x), static_cast<int32_t>(y));
+            }
+            count += end - begin;
+        }
+        return count;
+    }
+};
+
+namespace {
+    // Encodes the geometry of one feature into a store
+    void store_feature(VtzGeometryStoreHandle& store, const vtzero::feature& feature, uint32_t layer_index,
+                       StoreGeometryHandler& handler, std::vector<uint32_t>& values) {
+        VtzGeometryStoreHandle::Feature record{};
+        record.first_part = static_cast<uint32_t>(store.part_offsets.size());
+        record.layer_index = layer_index;
+        record.geometry_type = static_cast<uint8_t>(feature.geometry_type());
+
+        handler.clear();
+        try {
+            const auto geometry = feature.geometry();
+            GeometryCommandDecoder decoder{geometry};
+            switch (geometry.type()) {
+                case vtzero::GeomType::POINT:
+                    decoder.decode_point(handler);
+                    break;
+                case vtzero::GeomType::LINESTRING:
+                    decoder.decode_linestring(handler);
+                    break;
+                case vtzero::GeomType::POLYGON:
+                    decoder.decode_polygon(handler);
+                    break;
+                default:
+                    break;
+            }
+        } catch (const vtzero::geometry_exception&) {
+            handler.clear();  // Stored without parts
+        } catch (const protozero::exception&) {
+            handler.clear();  // Truncated geometry data
+        }
+
+        // Zigzag deltas, restarting at each part so parts decode independently
+        values.clear();
+        uint32_t max_value = 0;
+        for (size_t part = 0; part < handler.part_offsets.size(); ++part) {
+            const size_t end = part + 1 < handler.part_offsets.size() ? handler.part_offsets[part + 1]
+                                                                      : handler.points.size();
+            uint32_t x = 0;
+            uint32_t y = 0;
+            for (size_t i = handler.part_offsets[part]; i < end; ++i) {
+                const auto px = static_cast<uint32_t>(handler.points[i].x);
+                const auto py = static_cast<uint32_t>(handler.points[i].y);
+                values.push_back(zigzag_encode(px - x));
+                values.push_back(zigzag_encode(py - y));
+                max_value = std::max(max_value, std::max(values[values.size() - 2], values.back()));
+                x = px;
+                y = py;
+            }
+        }
+
+        record.part_count = static_cast<uint32_t>(handler.part_offsets.size());
+        record.point_count = static_cast<uint32_t>(handler.points.size());
+        record.wide = max_value > std::numeric_limits<uint16_t>::max();
+        if (record.wide) {
+            record.value_offset = static_cast<uint32_t>(store.wide.size());
+            store.wide.insert(store.wide.end(), values.begin(), values.end());
+        } else {
+            record.value_offset = static_cast<uint32_t>(store.narrow.size());
+            store.narrow.insert(store.narrow.end(), values.begin(), values.end());
+        }
+        store.part_offsets.insert(store.part_offsets.end(), handler.part_offsets.begin(),
+                                  handler.part_offsets.end());
+        store.features.push_back(record);
+    }
+
+    // Appends a partial store built for a range of features, rebasing its offsets
+    void append_store(VtzGeometryStoreHandle& store, const VtzGeometryStoreHandle& part) {
+        const auto narrow_base = static_cast<uint32_t>(store.narrow.size());
+        const auto wide_base = static_cast<uint32_t>(store.wide.size());
+        const auto part_base = static_cast<uint32_t>(store.part_offsets.size());
+        for (auto feature : part.features) {
+            feature.value_offset += feature.wide ? wide_base : narrow_base;
+            feature.first_part += part_base;
+            store.features.push_back(feature);
+        }
+        store.part_offsets.insert(store.part_offsets.end(), part.part_offsets.begin(), part.part_offsets.end());
+        store.narrow.insert(store.narrow.end(), part.narrow.begin(), part.narrow.end());
+        store.wide.insert(store.wide.end(), part.wide.begin(), part.wide.end());
+    }
+
+    // Builds a geometry store, splitting the tile's features into contiguous ranges that
+    // worker threads encode into their own partial stores. The ranges are balanced by
+    // feature message size, so a very large layer is spread over several workers, and the
+    // partial stores are appended in tile order.
+    VtzGeometryStoreHandle* build_geometry_store(const VtzTileHandle& tile_handle, uint32_t thread_count) {
+        struct FeatureRef {
+            uint32_t layer_index;
+            vtzero::data_view data;
+        };
+
+        struct Task {
+            size_t begin;
+            size_t end;
+            VtzGeometryStoreHandle store;
+        };
+
+        std::unique_ptr<VtzGeometryStoreHandle> store(new VtzGeometryStoreHandle());
+        std::vector<vtzero::layer> layers;
+        std::vector<FeatureRef> features;
+        size_t total_bytes = 0;
+
+        // Iterate a copy so the handle's layer iterator does not move
+        vtzero::vector_tile tile = tile_handle.tile;
+        tile.reset_layer();
+        while (auto layer = tile.next_layer()) {
+            const auto name = layer.name();
+            const auto layer_index = static_cast<uint32_t>(layers.size());
+            store->layers.push_back({std::string(name.data(), name.size()), layer.extent(),
+                                     static_cast<uint32_t>(features.size()), 0});
+
+            protozero::pbf_message<vtzero::detail::pbf_layer> reader{layer.data()};
+            while (reader.next(vtzero::detail::pbf_layer::features)) {
+                features.push_back({layer_index, reader.get_view()});
+                total_bytes += features.back().data.size();
+            }
+            store->layers.back().feature_count =
+                static_cast<uint32_t>(features.size()) - store->layers.back().first_feature;
+            layers.push_back(std::move(layer));
+        }
+
+        if (thread_count == 0) {
+            // Queried once, it reads sysfs on some platforms
+            static const uint32_t hardware_threads = std::max(1U, std::thread::hardware_concurrency());
+            thread_count = hardware_threads;
+        }
+        // Starting a worker costs more than encoding a small tile
+        const size_t min_worker_bytes = 64 * 1024;
+        thread_count = static_cast<uint32_t>(
+            std::max<size_t>(1, std::min<size_t>(thread_count, total_bytes / min_worker_bytes)));
+
+        // A few ranges per worker so uneven features still balance
+        std::vector<Task> tasks;
+        const size_t target_bytes = thread_count > 1 ? total_bytes / (thread_count * 4) + 1 : total_bytes + 1;
+        size_t begin = 0;
+        size_t bytes = 0;
+        for (size_t i = 0; i < features.size(); ++i) {
+            bytes += features[i].data.size();
+            if (bytes >= target_bytes || i + 1 == features.size()) {
+                tasks.push_back({begin, i + 1, VtzGeometryStoreHandle()});
+                begin = i + 1;
+                bytes = 0;
+            }
+        }
+
+        std::atomic<size_t> next_task{0};
+        std::mutex error_mutex;
+        std::exception_ptr error;
+
+        auto work = [&]() {
+            StoreGeometryHandler handler;
+            std::vector<uint32_t> values;
+            try {
+                for (size_t t = next_task.fetch_add(1); t < tasks.size(); t = next_task.fetch_add(1)) {
+                    auto& task = tasks[t];
+                    for (size_t i = task.begin; i < task.end; ++i) {
+                        const auto& ref = features[i];
+                        store_feature(task.store, vtzero::feature{&layers[ref.layer_index], ref.data},
+                                      ref.layer_index, handler, values);
+                    }
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) error = std::current_exception();
+                next_task.store(tasks.size());  // Stop the other workers
+            }
+        };
+
+        const size_t worker_count = std::min<size_t>(thread_count, tasks.size());
+        if (worker_count > 1) {
+            std::vector<std::thread> workers;
+            workers.reserve(worker_count - 1);
+            for (size_t i = 1; i < worker_count; ++i) {
+                workers.emplace_back(work);
+            }
+            work();
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        } else {
+            work();
+        }
+        if (error) std::rethrow_exception(error);
+
+        if (tasks.size() == 1) {
+            store->features = std::move(tasks[0].store.features);
+            store->part_offsets = std::move(tasks[0].store.part_offsets);
+            store->narrow = std::move(tasks[0].store.narrow);
+            store->wide = std::move(tasks[0].store.wide);
+        } else {
+            size_t feature_count = 0, part_count = 0, narrow_count = 0, wide_count = 0;
+            for (const auto& task : tasks) {
+                feature_count += task.store.features.size();
+                part_count += task.store.part_offsets.size();
+                narrow_count += task.store.narrow.size();
+                wide_count += task.store.wide.size();
+            }
+            store->features.reserve(feature_count);
+            store->part_offsets.reserve(part_count);
+            store->narrow.reserve(narrow_count);
+            store->wide.reserve(wide_count);
+            for (auto& task : tasks) {
+                append_store(*store, task.store);
+                task.store = VtzGeometryStoreHandle();  // Release the partial store early
+            }
+        }
+
+        store->shrink_to_fit();
+        return store.release();
+    }
+}
+
+FFI_PLUGIN_EXPORT VtzGeometryStoreHandle* vtz_geometry_store_create(VtzTileHandle* tile_handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_GEOMETRY_STORE_CREATE);
+    clear_exception();
+    if (!tile_handle) return nullptr;
+
+    try {
+        return build_geometry_store(*tile_handle, 1);
+    } catch (const vtzero::version_exception& e) {
+        set_exception(VTZ_EXCEPTION_VERSION, e.what());
+        return nullptr;
+    } catch (const vtzero::format_exception& e) {
+        set_exception(VTZ_EXCEPTION_FORMAT, e.what());
+        return nullptr;
+    } catch (const std::exception& e) {
+        set_exception(VTZ_EXCEPTION_FORMAT, e.what());
+        return nullptr;
+    } catch (...) {
+        set_exception(VTZ_EXCEPTION_FORMAT, "Unknown exception");
+        return nullptr;
+    }
+}
+
+FFI_PLUGIN_EXPORT VtzGeometryStoreHandle* vtz_geometry_store_create_parallel(VtzTileHandle* tile_handle,
+                                                                             uint32_t thread_count) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_GEOMETRY_STORE_CREATE_PARALLEL);
+    clear_exception();
+    if (!tile_handle) return nullptr;
+
+    try {
+        return build_geometry_store(*tile_handle, thread_count);
+    } catch (const vtzero::version_exception& e) {
+        set_exception(VTZ_EXCEPTION_VERSION, e.what());
+        return nullptr;
+    } catch (const vtzero::format_exception& e) {
+        set_exception(VTZ_EXCEPTION_FORMAT, e.what());
+        return nullptr;
+    } catch (const std::exception& e) {
+        set_exception(VTZ_EXCEPTION_FORMAT, e.what());
+        return nullptr;
+    } catch (...) {
+        set_exception(VTZ_EXCEPTION_FORMAT, "Unknown exception");
+        return nullptr;
+    }
+}
+
+FFI_PLUGIN_EXPORT size_t vtz_geometry_store_layer_count(VtzGeometryStoreHandle* store_handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_GEOMETRY_STORE_LAYER_COUNT);
+    if (!store_handle) return 0;
+    return store_handle->layers.size();
+}
+
+FFI_PLUGIN_EXPORT VtzGeometryStoreLayer vtz_geometry_store_layer(VtzGeometryStoreHandle* store_handle,
+                                                                 size_t index) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_GEOMETRY_STORE_LAYER);
+    VtzGeometryStoreLayer result{nullptr, 0, 0, 0};
+    if (!store_handle || index >= store_handle->layers.size()) return result;
+
+    const auto& layer = store_handle->layers[index];
+    result.name = layer.name.c_str();
+    result.extent = layer.extent;
+    result.first_feature = layer.first_feature;
+    result.feature_count = layer.feature_count;
+    return result;
+}
+
+FFI_PLUGIN_EXPORT size_t vtz_geometry_store_feature_count(VtzGeometryStoreHandle* store_handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_GEOMETRY_STORE_FEATURE_COUNT);
+    if (!store_handle) return 0;
+    return store_handle->features.size();
+}
+
+FFI_PLUGIN_EXPORT VtzGeometryStoreFeature vtz_geometry_store_feature(VtzGeometryStoreHandle* store_handle,
+                                                                     size_t index) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_GEOMETRY_STORE_FEATURE);
+    VtzGeometryStoreFeature result{0, 0, 0, 0};
+    if (!store_handle || index >= store_handle->features.size()) return result;
+
+    const auto& feature = store_handle->features[index];
+    result.geometry_type = feature.geometry_type;
+    result.layer_index = feature.layer_index;
+    result.part_count = feature.part_count;
+    result.point_count = feature.point_count;
+    return result;
+}
+
+FFI_PLUGIN_EXPORT size_t vtz_geometry_store_part_offsets(VtzGeometryStoreHandle* store_handle,
+                                                         size_t index,
+                                                         uint32_t* out,
+                                                         size_t capacity) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_GEOMETRY_STORE_PART_OFFSETS);
+    if (!store_handle || index >= store_handle->features.size()) return 0;
+    if (!out) capacity = 0;
+
+    const auto& feature = store_handle->features[index];
+    const size_t count = static_cast<size_t>(feature.part_count) + 1;
+    const auto begin = store_handle->part_offsets.begin() + feature.first_part;
+    std::copy(begin, begin + std::min<size_t>(feature.part_count, capacity), out);
+    if (capacity >= count) {
+        out[feature.part_count] = feature.point_count;
+    }
+    return count;
+}
+
+FFI_PLUGIN_EXPORT size_t vtz_geometry_store_decode(VtzGeometryStoreHandle* store_handle,
+                                                   size_t index,
+                                                   uint32_t part_begin,
+                                                   uint32_t part_end,
+                                                   int32_t* out,
+                                                   size_t capacity) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_GEOMETRY_STORE_DECODE);
+    if (!store_handle || index >= store_handle->features.size()) return 0;
+    if (!out) capacity = 0;
+
+    size_t written = 0;
+    return store_handle->decode(store_handle->features[index], part_begin, part_end,
+                                [&](int32_t x, int32_t y) {
+                                    if (written < capacity) {
+                                        out[2 * written] = x;
+                                        out[2 * written + 1] = y;
+                                        ++written;
+                                    }
+                                });
+}
+
+FFI_PLUGIN_EXPORT size_t vtz_geometry_store_project(VtzGeometryStoreHandle* store_handle,
+                                                    size_t index,
+                                                    uint32_t part_begin,
+                                                    uint32_t part_end,
+                                                    uint32_t tile_z,
+                                                    uint32_t tile_x,
+                                                    uint32_t tile_y,
+                                                    double* out,
+                                                    size_t capacity) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_GEOMETRY_STORE_PROJECT);
+    if (!store_handle || index >= store_handle->features.size()) return 0;
+    if (!out) capacity = 0;
+
+    const auto& feature = store_handle->features[index];
+    const Wgs84Projection projection(store_handle->layers[feature.layer_index].extent,
+                                     static_cast<int32_t>(tile_x), static_cast<int32_t>(tile_y), tile_z);
+
+    size_t written = 0;
+    return store_handle->decode(feature, part_begin, part_end, [&](int32_t x, int32_t y) {
+        if (written < capacity) {
+            projection(x, y, out[2 * written], out[2 * written + 1]);
+            ++written;
+        }
+    });
+}
+
+FFI_PLUGIN_EXPORT size_t vtz_geometry_store_byte_size(VtzGeometryStoreHandle* store_handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_GEOMETRY_STORE_BYTE_SIZE);
+    if (!store_handle) return 0;
+    return store_handle->byte_size();
+}
+
+FFI_PLUGIN_EXPORT void vtz_geometry_store_free(VtzGeometryStoreHandle* store_handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_GEOMETRY_STORE_FREE);
+    delete store_handle;
+}
+
+// Incremental decode sessions
+struct VtzDecodeSessionHandle {
+    vtzero::vector_tile tile;  // Layer cursor, a copy of the tile handle's
+    vtzero::layer layer;       // Layer being decoded
+    protozero::pbf_message<vtzero::detail::pbf_layer> features;  // Feature cursor within it
+    bool in_layer = false;
+    bool done = false;
+
+    VtzGeometryStoreHandle store;
+    StoreGeometryHandler handler;
+    std::vector<uint32_t> values;
+
+    explicit VtzDecodeSessionHandle(const vtzero::vector_tile& source) : tile(source) {
+        tile.reset_layer();
+    }
+};
+
+FFI_PLUGIN_EXPORT VtzDecodeSessionHandle* vtz_decode_session_create(VtzTileHandle* tile_handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_DECODE_SESSION_CREATE);
+    clear_exception();
+    if (!tile_handle) return nullptr;
+
+    try {
+        return new VtzDecodeSessionHandle(tile_handle->tile);
+    } catch (const std::exception& e) {
+        set_exception(VTZ_EXCEPTION_FORMAT, e.what());
+        return nullptr;
+    } catch (...) {
+        set_exception(VTZ_EXCEPTION_FORMAT, "Unknown exception");
+        return nullptr;
+    }
+}
+
+FFI_PLUGIN_EXPORT size_t vtz_decode_session_step(VtzDecodeSessionHandle* session_handle,
+                                                 uint32_t budget_us,
+                                                 uint32_t max_features) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_DECODE_SESSION_STEP);
+    clear_exception();
+    if (!session_handle || session_handle->done) return 0;
+
+    auto& session = *session_handle;
+    auto& store = session.store;
+    const auto start = std::chrono::steady_clock::now();
+    const auto budget = std::chrono::microseconds(budget_us);
+    size_t decoded = 0;
+
+    try {
+        // At least one feature per step, so every call makes progress
+        while ((max_features == 0 || decoded < max_features) &&
+               (budget_us == 0 || decoded == 0 || std::chrono::steady_clock::now() - start < budget)) {
+            if (!session.in_layer) {
+                session.layer = session.tile.next_layer();
+                if (!session.layer) {
+                    session.done = true;
+                    store.shrink_to_fit();
+                    break;
+                }
+                const auto name = session.layer.name();
+                store.layers.push_back({std::string(name.data(), name.size()), session.layer.extent(),
+                                        static_cast<uint32_t>(store.features.size()), 0});
+                session.features = protozero::pbf_message<vtzero::detail::pbf_layer>{session.layer.data()};
+                session.in_layer = true;
+            }
+
+            if (!session.features.next(vtzero::detail::pbf_layer::features)) {
+                session.in_layer = false;
+                continue;
+            }
+            const auto layer_index = static_cast<uint32_t>(store.layers.size() - 1);
+            store_feature(store, vtzero::feature{&session.layer, session.features.get_view()},
+                          layer_index, session.handler, session.values);
+            ++store.layers.back().feature_count;
+            ++decoded;
+        }
+        return decoded;
+    } catch (const vtzero::version_exception& e) {
+        set_exception(VTZ_EXCEPTION_VERSION, e.what());
+    } catch (const vtzero::format_exception& e) {
+        set_exception(VTZ_EXCEPTION_FORMAT, e.what());
+    } catch (const std::exception& e) {
+        set_exception(VTZ_EXCEPTION_FORMAT, e.what());
+    } catch (...) {
+        set_exception(VTZ_EXCEPTION_FORMAT, "Unknown exception");
+    }
+    // The cursor cannot move past a malformed layer
+    session.done = true;
+    return decoded;
+}
+
+FFI_PLUGIN_EXPORT bool vtz_decode_session_done(VtzDecodeSessionHandle* session_handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_DECODE_SESSION_DONE);
+    if (!session_handle) return true;
+    return session_handle->done;
+}
+
+FFI_PLUGIN_EXPORT VtzGeometryStoreHandle* vtz_decode_session_store(VtzDecodeSessionHandle* session_handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_DECODE_SESSION_STORE);
+    if (!session_handle) return nullptr;
+    return &session_handle->store;
+}
+
+FFI_PLUGIN_EXPORT void vtz_decode_session_free(VtzDecodeSessionHandle* session_handle) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_DECODE_SESSION_FREE);
+    delete session_handle;
+}
+
+// Exception handling API
+FFI_PLUGIN_EXPORT VtzExceptionType vtz_get_last_exception_type(void) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_GET_LAST_EXCEPTION_TYPE);
+    std::lock_guard<std::mutex> lock(g_exception_mutex);
+    return g_exception_storage.type;
+}
+
+FFI_PLUGIN_EXPORT const char* vtz_get_last_exception_message(void) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_GET_LAST_EXCEPTION_MESSAGE);
+    std::lock_guard<std::mutex> lock(g_exception_mutex);
     if (g_exception_storage.message.empty()) {
         return nullptr;
     }
@@ -820,5 +3501,47 @@ FFI_PLUGIN_EXPORT const char* vtz_get_last_exception_message(void) {
 }
 
 FFI_PLUGIN_EXPORT void vtz_clear_exception(void) {
+    VTZ_STATS_CALL(VTZ_STATS_FN_CLEAR_EXCEPTION);
     clear_exception();
 }
+
+// Instrumentation API
+FFI_PLUGIN_EXPORT void vtz_stats_snapshot(VtzStatsSnapshot* out) {
+    if (!out) return;
+    std::memset(out, 0, sizeof(*out));
+
+#ifdef VTZ_ENABLE_STATS
+    out->enabled = true;
+    for (int i = 0; i < VTZ_STATS_FUNCTION_COUNT; ++i) {
+        out->calls[i] = g_stats.calls[i].load(std::memory_order_relaxed);
+    }
+    for (int i = 0; i < VTZ_STATS_LATENCY_COUNT; ++i) {
+        out->latency_total_ns[i] = g_stats.latency_total_ns[i].load(std::memory_order_relaxed);
+        for (int b = 0; b < VTZ_STATS_LATENCY_BUCKETS; ++b) {
+            out->latency_histogram[i][b] = g_stats.latency_histogram[i][b].load(std::memory_order_relaxed);
+        }
+    }
+    out->bytes_processed = g_stats.bytes_processed.load(std::memory_order_relaxed);
+    out->vertices_emitted = g_stats.vertices_emitted.load(std::memory_order_relaxed);
+    out->live_tiles = g_stats.live_tiles.load(std::memory_order_relaxed);
+    out->live_layers = g_stats.live_layers.load(std::memory_order_relaxed);
+    out->live_features = g_stats.live_features.load(std::memory_order_relaxed);
+    out->live_property_values = g_stats.live_property_values.load(std::memory_order_relaxed);
+#endif
+}
+
+FFI_PLUGIN_EXPORT void vtz_stats_reset(void) {
+#ifdef VTZ_ENABLE_STATS
+    for (auto& counter : g_stats.calls) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+    for (int i = 0; i < VTZ_STATS_LATENCY_COUNT; ++i) {
+        g_stats.latency_total_ns[i].store(0, std::memory_order_relaxed);
+        for (auto& bucket : g_stats.latency_histogram[i]) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+    g_stats.bytes_processed.store(0, std::memory_order_relaxed);
+    g_stats.vertices_emitted.store(0, std::memory_order_relaxed);
+#endif
+}
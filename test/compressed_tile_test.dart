@@ -0,0 +1,65 @@
+import 'dart:io';
+import 'dart:typed_data';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:vtzero_dart/vtzero_dart.dart';
+
+void main() {
+  group('VtzTile.fromCompressedBytes()', () {
+    test('gzip compressed tile decodes like the raw tile', () {
+      final bytes = File('test/data/chart.pbf').readAsBytesSync();
+      final compressed = Uint8List.fromList(gzip.encode(bytes));
+
+      final raw = VtzTile.fromBytes(bytes);
+      final inflated = VtzTile.fromCompressedBytes(compressed);
+
+      final rawLayers = raw.getLayers();
+      final inflatedLayers = inflated.getLayers();
+      expect(inflatedLayers.map((l) => l.name),
+          rawLayers.map((l) => l.name).toList());
+
+      for (var i = 0; i < rawLayers.length; i++) {
+        expect(inflatedLayers[i].featureCount, rawLayers[i].featureCount);
+        rawLayers[i].dispose();
+        inflatedLayers[i].dispose();
+      }
+
+      raw.dispose();
+      inflated.dispose();
+    });
+
+    test('zlib compressed tile decodes', () {
+      final bytes = File('test/fixtures/017/tile.mvt').readAsBytesSync();
+      final compressed = Uint8List.fromList(zlib.encode(bytes));
+
+      final tile = VtzTile.fromCompressedBytes(compressed);
+      final layers = tile.getLayers();
+      expect(layers, hasLength(1));
+      expect(layers[0].name, 'hello');
+
+      final features = layers[0].getFeatures();
+      expect(features, hasLength(1));
+      expect(features[0].id, 1);
+
+      tile.dispose();
+    });
+
+    test('Uncompressed bytes are accepted', () {
+      final bytes = File('test/fixtures/017/tile.mvt').readAsBytesSync();
+
+      final tile = VtzTile.fromCompressedBytes(bytes);
+      expect(tile.getLayers(), hasLength(1));
+
+      tile.dispose();
+    });
+
+    test('Truncated gzip data throws format exception', () {
+      final bytes = File('test/data/chart.pbf').readAsBytesSync();
+      final compressed = gzip.encode(bytes);
+      final truncated =
+          Uint8List.fromList(compressed.sublist(0, compressed.length ~/ 2));
+
+      expect(() => VtzTile.fromCompressedBytes(truncated),
+          throwsA(isA<VtzFormatException>()));
+    });
+  });
+}
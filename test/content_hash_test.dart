@@ -0,0 +1,89 @@
+import 'dart:io';
+import 'dart:typed_data';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:vtzero_dart/vtzero_dart.dart';
+import 'mvt_builder.dart';
+
+void main() {
+  group('Content hashing', () {
+    test('Known XXH64 values', () {
+      String hex(String input) {
+        final tile = VtzTile.fromBytes(Uint8List.fromList(input.codeUnits));
+        final hash = tile.contentHash;
+        tile.dispose();
+        return BigInt.from(hash).toUnsigned(64).toRadixString(16);
+      }
+
+      // XXH64 with seed 0
+      expect(hex('a'), 'd24ec4f1a98c6e5b');
+      expect(hex('abc'), '44bc2cf5ad770999');
+    });
+
+    test('Hashes are stable across tile instances', () {
+      final bytes = File('test/data/chart.pbf').readAsBytesSync();
+      final a = VtzTile.fromBytes(bytes);
+      final b = VtzTile.fromCompressedBytes(bytes);
+      expect(a.contentHash, b.contentHash);
+
+      final layersA = a.getLayers();
+      final layersB = b.getLayers();
+      for (var i = 0; i < layersA.length; i++) {
+        expect(layersA[i].contentHash, layersB[i].contentHash);
+        expect(layersA[i].featureHashes(), layersB[i].featureHashes());
+        layersA[i].dispose();
+        layersB[i].dispose();
+      }
+      expect(
+        layersA.map((l) => l.contentHash).toSet(),
+        hasLength(layersA.length),
+      );
+
+      a.dispose();
+      b.dispose();
+    });
+
+    test('Only changed layers and features hash differently', () {
+      List<int> line(int x) => MvtBuilder.feature(
+        type: 2,
+        geometry: MvtBuilder.linestrings([
+          [[x, 0], [x, 10]],
+        ]),
+        id: x,
+      );
+
+      final before = VtzTile.fromBytes(MvtBuilder.tile([
+        MvtBuilder.layer('roads', [line(1), line(2), line(3)]),
+        MvtBuilder.layer('water', [line(4)]),
+      ]));
+      final after = VtzTile.fromBytes(MvtBuilder.tile([
+        MvtBuilder.layer('roads', [line(1), line(5), line(3)]),
+        MvtBuilder.layer('water', [line(4)]),
+      ]));
+      expect(before.contentHash, isNot(after.contentHash));
+
+      final roadsBefore = before.getLayer('roads')!;
+      final roadsAfter = after.getLayer('roads')!;
+      expect(roadsBefore.contentHash, isNot(roadsAfter.contentHash));
+
+      final hashesBefore = roadsBefore.featureHashes();
+      final hashesAfter = roadsAfter.featureHashes();
+      expect(hashesBefore, hasLength(3));
+      expect(hashesAfter[0], hashesBefore[0]);
+      expect(hashesAfter[1], isNot(hashesBefore[1]));
+      expect(hashesAfter[2], hashesBefore[2]);
+
+      // Hashing does not move the feature iterator
+      expect(roadsAfter.getFeatures(), hasLength(3));
+
+      final waterBefore = before.getLayer('water')!;
+      final waterAfter = after.getLayer('water')!;
+      expect(waterBefore.contentHash, waterAfter.contentHash);
+
+      for (final layer in [roadsBefore, roadsAfter, waterBefore, waterAfter]) {
+        layer.dispose();
+      }
+      before.dispose();
+      after.dispose();
+    });
+  });
+}
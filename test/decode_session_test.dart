@@ -0,0 +1,121 @@
+import 'dart:io';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:vtzero_dart/vtzero_dart.dart';
+import 'fixture_helper.dart';
+
+void main() {
+  group('VtzDecodeSession', () {
+    final bytes = File('test/data/chart.pbf').readAsBytesSync();
+
+    test('Stepping by feature count builds the full store', () {
+      final tile = VtzTile.fromBytes(bytes);
+      final full = VtzGeometryStore.fromTile(tile);
+      final session = VtzDecodeSession(tile);
+
+      var total = 0;
+      var steps = 0;
+      while (!session.isDone) {
+        final decoded = session.step(maxFeatures: 10);
+        expect(decoded, lessThanOrEqualTo(10));
+        total += decoded;
+        steps++;
+
+        // Everything decoded so far is readable between steps
+        final partial = session.store;
+        expect(partial.featureCount, total);
+        if (total > 0) {
+          expect(partial[total - 1].toList(), full[total - 1].toList());
+        }
+      }
+      expect(total, full.featureCount);
+      expect(steps, greaterThan(full.featureCount ~/ 10));
+
+      final store = session.store;
+      expect(
+        store.layers.map((l) => (l.name, l.firstFeature, l.featureCount)),
+        full.layers.map((l) => (l.name, l.firstFeature, l.featureCount)),
+      );
+      for (var i = 0; i < full.featureCount; i++) {
+        expect(store[i].coordinates(), full[i].coordinates());
+      }
+
+      session.dispose();
+      full.dispose();
+      tile.dispose();
+    });
+
+    test('Time budget always makes progress', () {
+      final tile = VtzTile.fromBytes(bytes);
+      final session = VtzDecodeSession(tile);
+
+      final decoded = session.step(budget: const Duration(microseconds: 1));
+      expect(decoded, greaterThanOrEqualTo(1));
+
+      // No limits decodes the rest
+      session.step();
+      expect(session.isDone, isTrue);
+      expect(session.step(), 0);
+
+      session.dispose();
+      tile.dispose();
+    });
+
+    test('Budgets beyond the native range decode everything', () {
+      final tile = VtzTile.fromBytes(bytes);
+      final session = VtzDecodeSession(tile);
+
+      // 2^32 + 1 us would wrap to a 1us budget as a uint32
+      session.step(budget: const Duration(microseconds: 0x100000001));
+      expect(session.isDone, isTrue);
+
+      session.dispose();
+      tile.dispose();
+    });
+
+    test('Stepping after the tile is disposed throws', () {
+      final tile = VtzTile.fromBytes(bytes);
+      final session = VtzDecodeSession(tile);
+      session.step(maxFeatures: 1);
+
+      tile.dispose();
+      expect(() => session.step(), throwsStateError);
+      expect(session.store.featureCount, 1);
+
+      session.dispose();
+    });
+
+    test('Store views throw after the session is disposed', () {
+      final tile = VtzTile.fromBytes(bytes);
+      final session = VtzDecodeSession(tile);
+      session.step(maxFeatures: 1);
+
+      final store = session.store;
+      final geometry = store[0];
+      session.dispose();
+
+      expect(() => store.featureCount, throwsStateError);
+      expect(() => store.byteSize, throwsStateError);
+      expect(() => store[0], throwsStateError);
+      expect(() => geometry.partOffsets, throwsStateError);
+      expect(() => geometry.coordinates(), throwsStateError);
+      expect(
+        () => geometry.lonLat(tileZ: 0, tileX: 0, tileY: 0),
+        throwsStateError,
+      );
+      expect(() => session.store, throwsStateError);
+
+      tile.dispose();
+    });
+
+    test('Malformed layer ends the session', () {
+      final tile = loadFixtureTile('004');
+      final session = VtzDecodeSession(tile);
+
+      expect(() => session.step(), throwsA(isA<VtzFormatException>()));
+      expect(session.isDone, isTrue);
+
+      session.dispose();
+      tile.dispose();
+    });
+  });
+}
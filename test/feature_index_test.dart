@@ -0,0 +1,90 @@
+import 'dart:io';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:vtzero_dart/vtzero_dart.dart';
+
+void main() {
+  group('Feature id index', () {
+    final bytes = File('test/data/chart.pbf').readAsBytesSync();
+
+    test('Lookups match a layer scan with and without the index', () {
+      final tile = VtzTile.fromBytes(bytes);
+      final layer = tile.getLayer('structure')!;
+
+      final features = layer.getFeatures();
+      final ids = features.map((f) => f.id!).toList();
+
+      for (final indexed in [false, true]) {
+        if (indexed) {
+          expect(layer.buildFeatureIndex(), ids.toSet().length);
+        }
+        for (var i = 0; i < ids.length; i++) {
+          final found = layer.getFeatureById(ids[i]);
+          expect(found, isNotNull);
+          expect(found!.id, ids[i]);
+          expect(found.decodeGeometry(), features[i].decodeGeometry());
+          found.dispose();
+        }
+        expect(layer.getFeatureById(1), isNull);
+      }
+
+      for (final feature in features) {
+        feature.dispose();
+      }
+      layer.dispose();
+      tile.dispose();
+    });
+
+    test('Lookups do not move the feature iterator', () {
+      final tile = VtzTile.fromBytes(bytes);
+      final layer = tile.getLayer('place_label')!;
+      final count = layer.featureCount;
+
+      final layer2 = tile.getLayer('place_label')!;
+      layer2.buildFeatureIndex();
+      layer2.getFeatureById(12297454990)!.dispose();
+      final features = layer2.getFeatures();
+      expect(features, hasLength(count));
+
+      for (final feature in features) {
+        feature.dispose();
+      }
+      layer2.dispose();
+      layer.dispose();
+      tile.dispose();
+    });
+
+    test('Batch lookup returns null for missing ids', () {
+      final tile = VtzTile.fromBytes(bytes);
+      final layer = tile.getLayer('poi_label')!;
+
+      for (final indexed in [false, true]) {
+        if (indexed) layer.buildFeatureIndex();
+
+        final features =
+            layer.getFeaturesByIds([42165882900, 7, 2743326101, 42165882900]);
+        expect(features.map((f) => f?.id),
+            [42165882900, null, 2743326101, 42165882900]);
+
+        for (final feature in features) {
+          feature?.dispose();
+        }
+      }
+
+      expect(layer.getFeaturesByIds([]), isEmpty);
+
+      layer.dispose();
+      tile.dispose();
+    });
+
+    test('Layers without ids have an empty index', () {
+      final tile = VtzTile.fromBytes(bytes);
+      final layer = tile.getLayer('road')!;
+
+      expect(layer.buildFeatureIndex(), 0);
+      expect(layer.getFeatureById(0), isNull);
+
+      layer.dispose();
+      tile.dispose();
+    });
+  });
+}
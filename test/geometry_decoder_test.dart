@@ -0,0 +1,72 @@
+import 'package:flutter_test/flutter_test.dart';
+import 'package:vtzero_dart/vtzero_dart.dart';
+import 'mvt_builder.dart';
+
+void main() {
+  group('Geometry command decoding', () {
+    VtzFeature? feature;
+    VtzLayer? layer;
+    VtzTile? tile;
+
+    VtzFeature decode(int type, List<int> geometry) {
+      tile = VtzTile.fromBytes(MvtBuilder.tile([
+        MvtBuilder.layer('test', [
+          MvtBuilder.feature(type: type, geometry: geometry),
+        ]),
+      ]));
+      layer = tile!.getLayers().first;
+      return feature = layer!.getFeatures().first;
+    }
+
+    tearDown(() {
+      feature?.dispose();
+      layer?.dispose();
+      tile?.dispose();
+      feature = null;
+      layer = null;
+      tile = null;
+    });
+
+    test('Runs mixing one byte and multi-byte parameters', () {
+      final line = [
+        [0, 0], [3, -2], [100000, -70000], [100001, -69999], [-5, 5],
+      ];
+      final f = decode(2, MvtBuilder.linestrings([line]));
+      expect(f.decodeGeometry(), [
+        for (final p in line) [p[0].toDouble(), p[1].toDouble()],
+      ]);
+    });
+
+    test('Polygon rings are closed with their start point', () {
+      // MoveTo(1) LineTo(3) ClosePath(1)
+      final f = decode(3, [9, 0, 0, 26, 20, 0, 0, 20, 19, 0, 15]);
+      expect(f.decodeGeometry(), [
+        [[0.0, 0.0], [10.0, 0.0], [10.0, 10.0], [0.0, 10.0], [0.0, 0.0]],
+      ]);
+    });
+
+    final malformed = <String, (int, List<int>)>{
+      'Point without parameters': (1, [9]),
+      'MoveTo count of zero': (1, [1]),
+      'Trailing data after points': (1, [9, 2, 2, 9]),
+      'Count larger than the data': (2, [9, 0, 0, (1000 << 3) | 2, 2, 2]),
+      'Missing LineTo': (2, [9, 0, 0]),
+      'Linestring with a second MoveTo point': (2, [17, 0, 0, 2, 2]),
+      'Missing ClosePath': (3, [9, 0, 0, 18, 2, 0, 0, 2]),
+      'ClosePath count other than 1': (3, [9, 0, 0, 18, 2, 0, 0, 2, 23]),
+      'Unexpected command': (3, [9, 0, 0, 18, 2, 0, 0, 2, 10]),
+    };
+
+    for (final entry in malformed.entries) {
+      test(entry.key, () {
+        final (type, geometry) = entry.value;
+        final f = decode(type, geometry);
+        expect(f.decodeGeometry, throwsA(isA<VtzGeometryException>()));
+        expect(
+          () => f.decodeProjected(const VtzProjection.tile()),
+          throwsA(isA<VtzGeometryException>()),
+        );
+      });
+    }
+  });
+}
@@ -0,0 +1,148 @@
+import 'dart:io';
+import 'dart:math' as math;
+import 'dart:typed_data';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:vtzero_dart/vtzero_dart.dart';
+import 'fixture_helper.dart';
+import 'mvt_builder.dart';
+
+void main() {
+  group('VtzGeometryStore', () {
+    test('Stored geometry matches decodeGeometry for every feature', () {
+      final bytes = File('test/data/chart.pbf').readAsBytesSync();
+      final tile = VtzTile.fromBytes(bytes);
+      final store = VtzGeometryStore.fromTile(tile);
+
+      var index = 0;
+      var points = 0;
+      final layers = tile.getLayers();
+      expect(store.layers.map((l) => l.name), layers.map((l) => l.name));
+
+      for (var i = 0; i < layers.length; i++) {
+        expect(store.layers[i].firstFeature, index);
+        expect(store.layers[i].extent, layers[i].extent);
+
+        final features = layers[i].getFeatures();
+        expect(store.layers[i].featureCount, features.length);
+        for (final feature in features) {
+          final stored = store[index++];
+          expect(stored.layerIndex, i);
+          expect(stored.geometryType, feature.geometryType);
+          expect(stored.toList(), feature.decodeGeometry());
+          points += stored.pointCount;
+          feature.dispose();
+        }
+        layers[i].dispose();
+      }
+      expect(store.featureCount, index);
+
+      // A few bytes per vertex, against well over 100 for nested Dart lists
+      expect(store.byteSize, lessThan(points * 8));
+
+      store.dispose();
+      tile.dispose();
+    });
+
+    test('Parallel build matches the single threaded store', () {
+      // Concatenated tiles are one tile with the layers repeated, large
+      // enough to be split across workers
+      final chart = File('test/data/chart.pbf').readAsBytesSync();
+      final tile = VtzTile.fromBytes(
+        Uint8List.fromList([for (var i = 0; i < 20; i++) ...chart]),
+      );
+      final serial = VtzGeometryStore.fromTile(tile);
+
+      for (final threads in [0, 2, 3, 16]) {
+        final parallel = VtzGeometryStore.fromTile(tile, threads: threads);
+        expect(parallel.featureCount, serial.featureCount);
+        expect(parallel.byteSize, serial.byteSize);
+        expect(
+          parallel.layers.map((l) => (l.name, l.firstFeature, l.featureCount)),
+          serial.layers.map((l) => (l.name, l.firstFeature, l.featureCount)),
+        );
+        for (var i = 0; i < serial.featureCount; i++) {
+          expect(parallel[i].layerIndex, serial[i].layerIndex);
+          expect(parallel[i].partOffsets, serial[i].partOffsets);
+          expect(parallel[i].coordinates(), serial[i].coordinates());
+        }
+        parallel.dispose();
+      }
+
+      serial.dispose();
+      tile.dispose();
+    });
+
+    test('Parts decode independently', () {
+      // A square and a second polygon with a hole: three rings
+      final tile = loadFixtureTile('022');
+      final store = VtzGeometryStore.fromTile(tile);
+      tile.dispose();
+
+      final stored = store[0];
+      final rings = stored.toList();
+      expect(stored.partCount, rings.length);
+
+      final offsets = stored.partOffsets;
+      expect(offsets.first, 0);
+      expect(offsets.last, stored.pointCount);
+      for (var part = 0; part < stored.partCount; part++) {
+        final xy = stored.coordinates(partBegin: part, partEnd: part + 1);
+        expect(xy.length, (offsets[part + 1] - offsets[part]) * 2);
+        expect(xy[0], rings[part][0][0]);
+        expect(xy[1], rings[part][0][1]);
+      }
+
+      store.dispose();
+    });
+
+    test('Large deltas round-trip', () {
+      final bytes = MvtBuilder.tile([
+        MvtBuilder.layer('wide', [
+          MvtBuilder.feature(
+            type: 2,
+            geometry: MvtBuilder.linestrings([
+              [[0, 0], [100000, -70000], [5, 5]],
+            ]),
+          ),
+        ]),
+      ]);
+      final tile = VtzTile.fromBytes(bytes);
+      final store = VtzGeometryStore.fromTile(tile);
+      tile.dispose();
+
+      expect(store[0].coordinates(), [0, 0, 100000, -70000, 5, 5]);
+
+      store.dispose();
+    });
+
+    test('Projects to lon/lat', () {
+      final tile = loadFixtureTile('017');
+      final store = VtzGeometryStore.fromTile(tile);
+      tile.dispose();
+
+      // Point (25, 17) in tile 1/1/0 with extent 4096
+      final lonLat = store[0].lonLat(tileZ: 1, tileX: 1, tileY: 0);
+      final size = 4096.0 * 2;
+      final y2 = 180.0 - 17 * 360.0 / size;
+      expect(lonLat[0], closeTo((25 + 4096) * 360.0 / size - 180.0, 1e-9));
+      expect(
+        lonLat[1],
+        closeTo(360.0 / math.pi * math.atan(math.exp(y2 * math.pi / 180.0)) - 90.0, 1e-9),
+      );
+
+      store.dispose();
+    });
+
+    test('Invalid geometry is stored without parts', () {
+      final tile = loadFixtureTile('044');
+      final store = VtzGeometryStore.fromTile(tile);
+      tile.dispose();
+
+      expect(store.featureCount, 1);
+      expect(store[0].partCount, 0);
+      expect(store[0].toList(), isEmpty);
+
+      store.dispose();
+    });
+  });
+}
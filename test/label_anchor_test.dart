@@ -0,0 +1,124 @@
+import 'dart:io';
+import 'dart:math' as math;
+import 'package:flutter_test/flutter_test.dart';
+import 'package:vtzero_dart/vtzero_dart.dart';
+import 'fixture_helper.dart';
+
+void main() {
+  group('Label anchors', () {
+    test('Point centroid is the point', () {
+      final tile = loadFixtureTile('017');
+      final feature = checkLayer(tile);
+
+      final anchors = feature.labelAnchors(VtzLabelAnchorKind.centroid);
+      expect(anchors, hasLength(1));
+      expect(anchors[0].x, 25.0);
+      expect(anchors[0].y, 17.0);
+
+      // Polylabel and line anchors do not apply to points
+      expect(feature.labelAnchors(VtzLabelAnchorKind.polylabel), isEmpty);
+      expect(feature.labelAnchors(VtzLabelAnchorKind.line), isEmpty);
+
+      feature.dispose();
+      tile.dispose();
+    });
+
+    test('Linestring midpoint and evenly spaced anchors', () {
+      // (2, 2) -> (2, 10) -> (10, 10), length 16
+      final tile = loadFixtureTile('018');
+      final feature = checkLayer(tile);
+
+      final midpoint = feature.labelAnchors(VtzLabelAnchorKind.line);
+      expect(midpoint, hasLength(1));
+      expect(midpoint[0].x, 2.0);
+      expect(midpoint[0].y, 10.0);
+      expect(midpoint[0].angle, closeTo(math.pi / 2, 1e-9));
+      expect(midpoint[0].weight, 16.0);
+
+      final spaced = feature.labelAnchors(VtzLabelAnchorKind.line, count: 2);
+      expect(spaced, hasLength(2));
+      expect([spaced[0].x, spaced[0].y], [2.0, 6.0]);
+      expect(spaced[0].angle, closeTo(math.pi / 2, 1e-9));
+      expect([spaced[1].x, spaced[1].y], [6.0, 10.0]);
+      expect(spaced[1].angle, closeTo(0.0, 1e-9));
+
+      final centroid = feature.labelAnchors(VtzLabelAnchorKind.centroid);
+      expect([centroid[0].x, centroid[0].y], [4.0, 8.0]);
+
+      feature.dispose();
+      tile.dispose();
+    });
+
+    test('Polygon centroid and polylabel', () {
+      // Triangle (3, 6), (8, 12), (20, 34) with area 19
+      final tile = loadFixtureTile('019');
+      final feature = checkLayer(tile);
+
+      final centroid = feature.labelAnchors(VtzLabelAnchorKind.centroid);
+      expect(centroid, hasLength(1));
+      expect(centroid[0].x, closeTo(31 / 3, 1e-9));
+      expect(centroid[0].y, closeTo(52 / 3, 1e-9));
+      expect(centroid[0].weight, closeTo(19.0, 1e-9));
+
+      // The pole of a triangle is its incenter, the distance its inradius
+      final pole = feature.labelAnchors(
+        VtzLabelAnchorKind.polylabel,
+        precision: 0.01,
+      );
+      expect(pole, hasLength(1));
+      expect(pole[0].weight, closeTo(0.579, 0.01));
+
+      feature.dispose();
+      tile.dispose();
+    });
+
+    test('Multipolygon has one polylabel per polygon', () {
+      final tile = loadFixtureTile('022');
+      final feature = checkLayer(tile);
+
+      final poles = feature.labelAnchors(VtzLabelAnchorKind.polylabel);
+      expect(poles, hasLength(2));
+      expect(poles.map((a) => a.partIndex), [0, 1]);
+      expect([poles[0].x, poles[0].y, poles[0].weight], [5.0, 5.0, 5.0]);
+
+      feature.dispose();
+      tile.dispose();
+    });
+
+    test('Layer batch matches per-feature anchors', () {
+      final bytes = File('test/data/chart.pbf').readAsBytesSync();
+      final tile = VtzTile.fromBytes(bytes);
+
+      for (final layer in tile.getLayers()) {
+        final batch = layer.labelAnchors(VtzLabelAnchorKind.line, count: 3);
+        final features = layer.getFeatures();
+
+        final expected = <VtzLabelAnchor>[];
+        for (var i = 0; i < features.length; i++) {
+          for (final anchor in features[i].labelAnchors(
+            VtzLabelAnchorKind.line,
+            count: 3,
+          )) {
+            expected.add(anchor);
+            expect(anchor.featureIndex, 0);
+          }
+        }
+
+        expect(batch, hasLength(expected.length));
+        for (var i = 0; i < batch.length; i++) {
+          expect(batch[i].x, expected[i].x);
+          expect(batch[i].y, expected[i].y);
+          expect(batch[i].angle, expected[i].angle);
+          expect(batch[i].featureIndex, lessThan(features.length));
+        }
+
+        for (final feature in features) {
+          feature.dispose();
+        }
+        layer.dispose();
+      }
+
+      tile.dispose();
+    });
+  });
+}
@@ -0,0 +1,164 @@
+import 'dart:ffi';
+import 'package:ffi/ffi.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:vtzero_dart/vtzero_dart.dart';
+import 'package:vtzero_dart/src/vtz_bindings.dart';
+import 'package:vtzero_dart/vtzero_dart_bindings_generated.dart' as ffi_bindings;
+import 'mvt_builder.dart';
+
+void main() {
+  group('VtzLineMerger', () {
+    const extent = 4096;
+
+    // Contours in world coordinates of a 2x2 zoom 1 tile grid
+    final contours = <(List<List<int>>, int)>[
+      // Crosses tiles (0, 0) -> (1, 0) -> (1, 1)
+      ([[100, 1000], [5000, 1200], [6000, 7000]], 100),
+      // Crosses tiles (1, 1) -> (0, 1) -> (0, 0)
+      ([[7000, 7000], [3000, 6000], [3500, 100]], 200),
+      // Inside tile (0, 0)
+      ([[200, 200], [300, 300]], 100),
+    ];
+
+    // Every tile gets all contours in its tile coordinates; the parts outside
+    // the tile are clipped away by the merger
+    List<VtzMergeTile> buildTiles({List<List<int>> extra = const []}) {
+      final tiles = <VtzMergeTile>[];
+      for (var x = 0; x < 2; x++) {
+        for (var y = 0; y < 2; y++) {
+          final features = [
+            for (final (points, ele) in contours)
+              MvtBuilder.feature(
+                type: 2,
+                geometry: MvtBuilder.linestrings([
+                  [
+                    for (final p in points) [p[0] - x * extent, p[1] - y * extent],
+                  ],
+                ]),
+                id: ele,
+                tags: [0, ele == 100 ? 0 : 1],
+              ),
+            ...extra,
+          ];
+          final bytes = MvtBuilder.tile([
+            MvtBuilder.layer('contour', features, keys: ['ele'], values: [100, 200]),
+          ]);
+          tiles.add(VtzMergeTile(VtzTile.fromBytes(bytes), z: 1, x: x, y: y));
+        }
+      }
+      return tiles;
+    }
+
+    void disposeTiles(List<VtzMergeTile> tiles) {
+      for (final tile in tiles) {
+        tile.tile.dispose();
+      }
+    }
+
+    test('Joins contours across tile seams by property', () {
+      final tiles = buildTiles();
+      final merged = VtzLineMerger.merge(
+        tiles,
+        layer: 'contour',
+        keyKind: VtzMergeKeyKind.property,
+        property: 'ele',
+      );
+
+      expect(merged.worldSize, 2.0 * extent);
+      expect(merged.lines, hasLength(3));
+
+      final first = merged.lines.firstWhere((l) => l.pieceCount == 3 && l.key == '100');
+      expect(first.coordinates.first, 100.0);
+      expect(first.coordinates[1], 1000.0);
+      expect(first.coordinates[first.coordinates.length - 2], 6000.0);
+      expect(first.coordinates.last, 7000.0);
+      // Seam crossings are inserted where the line was clipped
+      expect(first.pointCount, 5);
+
+      final second = merged.lines.firstWhere((l) => l.key == '200');
+      expect(second.pieceCount, 3);
+
+      final inner = merged.lines.firstWhere((l) => l.pieceCount == 1);
+      expect(inner.key, '100');
+      expect(inner.coordinates, [200.0, 200.0, 300.0, 300.0]);
+
+      disposeTiles(tiles);
+    });
+
+    test('Feature ids and layer keys', () {
+      final tiles = buildTiles();
+
+      final byId = VtzLineMerger.merge(
+        tiles,
+        layer: 'contour',
+        keyKind: VtzMergeKeyKind.featureId,
+      );
+      expect(byId.lines.map((l) => l.key).toSet(), {'100', '200'});
+      expect(byId.lines.where((l) => l.pieceCount == 3), hasLength(2));
+
+      final byLayer = VtzLineMerger.merge(tiles, layer: 'contour');
+      expect(byLayer.lines.where((l) => l.pieceCount == 3), hasLength(2));
+
+      disposeTiles(tiles);
+    });
+
+    test('Lines without the key are not merged', () {
+      final tiles = buildTiles();
+      final merged = VtzLineMerger.merge(
+        tiles,
+        layer: 'contour',
+        keyKind: VtzMergeKeyKind.property,
+        property: 'missing',
+      );
+
+      expect(merged.lines.every((l) => l.pieceCount == 1), isTrue);
+      expect(merged.lines, hasLength(7));
+
+      disposeTiles(tiles);
+    });
+
+    test('Features with invalid geometry are skipped', () {
+      // MoveTo without a LineTo
+      final invalid = MvtBuilder.feature(type: 2, geometry: [9, 0, 0]);
+      final tiles = buildTiles(extra: [invalid]);
+      final merged = VtzLineMerger.merge(
+        tiles,
+        layer: 'contour',
+        keyKind: VtzMergeKeyKind.property,
+        property: 'ele',
+      );
+
+      expect(merged.lines, hasLength(3));
+      expect(merged.lines.where((l) => l.pieceCount == 3), hasLength(2));
+
+      disposeTiles(tiles);
+    });
+
+    test('Unknown key kinds are rejected', () {
+      // The Dart API only passes VtzMergeKeyKind values, so call the C API
+      final tilesPtr = calloc<ffi_bindings.VtzMergeTile>();
+      final layerPtr = 'contour'.toNativeUtf8();
+
+      final handle = bindings.vtz_merge_lines(
+        tilesPtr,
+        0,
+        layerPtr.cast(),
+        VtzMergeKeyKind.values.length,
+        nullptr,
+        1.0,
+      );
+
+      calloc.free(tilesPtr);
+      malloc.free(layerPtr);
+      expect(handle, nullptr);
+      expect(checkException, throwsA(isA<VtzOutOfRangeException>()));
+    });
+
+    test('World coordinates project to lon/lat', () {
+      const merged = VtzMergedLines(lines: [], worldSize: 8192);
+      final center = merged.toLonLat(4096, 4096);
+      expect(center.lon, closeTo(0, 1e-9));
+      expect(center.lat, closeTo(0, 1e-9));
+    });
+  });
+}
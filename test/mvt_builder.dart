@@ -0,0 +1,89 @@
+import 'dart:typed_data';
+
+/// Minimal MVT encoder for building test tiles
+class MvtBuilder {
+  static List<int> _varint(int value) {
+    final out = <int>[];
+    while (value >= 0x80) {
+      out.add((value & 0x7f) | 0x80);
+      value >>= 7;
+    }
+    out.add(value);
+    return out;
+  }
+
+  static List<int> _key(int field, int wireType) => _varint((field << 3) | wireType);
+
+  static List<int> _bytes(int field, List<int> bytes) =>
+      [..._key(field, 2), ..._varint(bytes.length), ...bytes];
+
+  static int _zigzag(int n) => (n << 1) ^ (n >> 63);
+
+  /// Geometry commands for one or more linestrings
+  static List<int> linestrings(List<List<List<int>>> lines) {
+    final commands = <int>[];
+    var cx = 0;
+    var cy = 0;
+    for (final line in lines) {
+      commands.add((1 << 3) | 1); // MoveTo(1)
+      commands.addAll([_zigzag(line[0][0] - cx), _zigzag(line[0][1] - cy)]);
+      cx = line[0][0];
+      cy = line[0][1];
+      commands.add(((line.length - 1) << 3) | 2); // LineTo(n)
+      for (final point in line.skip(1)) {
+        commands.addAll([_zigzag(point[0] - cx), _zigzag(point[1] - cy)]);
+        cx = point[0];
+        cy = point[1];
+      }
+    }
+    return commands;
+  }
+
+  /// Encode a feature; [tags] are key/value index pairs
+  static List<int> feature({
+    required int type,
+    required List<int> geometry,
+    int? id,
+    List<int> tags = const [],
+  }) {
+    return [
+      if (id != null) ...[..._key(1, 0), ..._varint(id)],
+      if (tags.isNotEmpty) ..._bytes(2, tags.expand(_varint).toList()),
+      ..._key(3, 0),
+      ..._varint(type),
+      ..._bytes(4, geometry.expand(_varint).toList()),
+    ];
+  }
+
+  /// Encode a version 2 layer with integer or string values
+  static List<int> layer(
+    String name,
+    List<List<int>> features, {
+    List<String> keys = const [],
+    List<Object> values = const [],
+    int extent = 4096,
+  }) {
+    return [
+      ..._key(15, 0),
+      ..._varint(2),
+      ..._bytes(1, name.codeUnits),
+      for (final feature in features) ..._bytes(2, feature),
+      for (final key in keys) ..._bytes(3, key.codeUnits),
+      for (final value in values)
+        ..._bytes(
+          4,
+          value is String
+              ? _bytes(1, value.codeUnits)
+              : [..._key(4, 0), ..._varint(value as int)],
+        ),
+      ..._key(5, 0),
+      ..._varint(extent),
+    ];
+  }
+
+  static Uint8List tile(List<List<int>> layers) {
+    return Uint8List.fromList([
+      for (final layer in layers) ..._bytes(3, layer),
+    ]);
+  }
+}
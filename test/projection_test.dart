@@ -0,0 +1,167 @@
+import 'dart:io';
+import 'dart:math' as math;
+import 'package:flutter_test/flutter_test.dart';
+import 'package:vtzero_dart/vtzero_dart.dart';
+import 'fixture_helper.dart';
+
+void main() {
+  group('VtzFeature.decodeProjected', () {
+    test('Tile and WGS84 projections match decodeGeometry and toGeoJson', () {
+      final bytes = File('test/data/chart.pbf').readAsBytesSync();
+      final tile = VtzTile.fromBytes(bytes);
+
+      for (final layer in tile.getLayers()) {
+        final wgs84 = VtzProjection.wgs84(
+          extent: layer.extent,
+          tileZ: 4,
+          tileX: 3,
+          tileY: 5,
+        );
+        for (final feature in layer.getFeatures()) {
+          final parts = feature.decodeGeometry();
+          final projected = feature.decodeProjected(const VtzProjection.tile());
+          expect(projected.partCount, parts.length);
+          expect(projected.coordinates, [
+            for (final part in parts)
+              for (final point in part) ...point,
+          ]);
+          expect(projected.partOffsets.last, projected.pointCount);
+
+          // GeoJSON output closes and reorients polygon rings, so compare
+          // points and linestrings exactly
+          if (feature.geometryType != VtzGeometryType.polygon) {
+            final geoJson = feature.toGeoJson(
+              extent: layer.extent,
+              tileX: 3,
+              tileY: 5,
+              tileZ: 4,
+            );
+            expect(feature.decodeProjected(wgs84).coordinates, [
+              for (final part in geoJson)
+                for (final point in part) ...point,
+            ]);
+          }
+          feature.dispose();
+        }
+        layer.dispose();
+      }
+
+      tile.dispose();
+    });
+
+    test('Web Mercator meters and screen transforms', () {
+      // Point (25, 17), extent 4096
+      final tile = loadFixtureTile('017');
+      final layer = tile.getLayers().first;
+      final feature = layer.getFeatures().first;
+
+      final meters = feature.decodeProjected(
+        const VtzProjection.webMercatorMeters(
+          extent: 4096,
+          tileZ: 1,
+          tileX: 1,
+          tileY: 0,
+        ),
+      );
+      const circumference = 2 * math.pi * 6378137.0;
+      expect(meters.coordinates[0], closeTo(25 * circumference / 8192, 1e-6));
+      expect(
+        meters.coordinates[1],
+        closeTo(circumference / 2 - 17 * circumference / 8192, 1e-6),
+      );
+
+      final lonLat = feature.decodeProjected(
+        const VtzProjection.wgs84(extent: 4096, tileZ: 1, tileX: 1, tileY: 0),
+      );
+      const radius = 6378137.0;
+      expect(
+        lonLat.coordinates[0],
+        closeTo(meters.coordinates[0] / radius * 180 / math.pi, 1e-9),
+      );
+      expect(
+        lonLat.coordinates[1],
+        closeTo(
+          (2 * math.atan(math.exp(meters.coordinates[1] / radius)) - math.pi / 2) *
+              180 /
+              math.pi,
+          1e-9,
+        ),
+      );
+
+      final screen = feature.decodeProjected(
+        VtzProjection.screen(a: 0.5, c: 10, e: -0.5, f: 256),
+      );
+      expect(screen.coordinates, [22.5, 247.5]);
+
+      feature.dispose();
+      layer.dispose();
+      tile.dispose();
+    });
+
+    test('Deep zooms project and out of range zooms throw', () {
+      // Point (25, 17), extent 4096
+      final tile = loadFixtureTile('017');
+      final layer = tile.getLayers().first;
+      final feature = layer.getFeatures().first;
+
+      final lonLat = feature.decodeProjected(
+        const VtzProjection.wgs84(extent: 4096, tileZ: 31, tileX: 0, tileY: 0),
+      );
+      expect(
+        lonLat.coordinates[0],
+        closeTo(25 * 360 / (4096 * math.pow(2, 31)) - 180, 1e-12),
+      );
+      expect(lonLat.coordinates[0], greaterThan(-180));
+
+      for (final tileZ in [-1, 32, 64]) {
+        expect(
+          () => feature.decodeProjected(
+            VtzProjection.wgs84(extent: 4096, tileZ: tileZ, tileX: 0, tileY: 0),
+          ),
+          throwsArgumentError,
+        );
+      }
+
+      feature.dispose();
+      layer.dispose();
+      tile.dispose();
+    });
+
+    test('Large geometries are decoded in full', () {
+      final bytes = File('test/data/chart.pbf').readAsBytesSync();
+      final tile = VtzTile.fromBytes(bytes);
+
+      var checked = false;
+      for (final layer in tile.getLayers()) {
+        for (final feature in layer.getFeatures()) {
+          final projected = feature.decodeProjected(const VtzProjection.tile());
+          if (projected.pointCount > 256) {
+            final points = feature.decodeGeometry().expand((p) => p).length;
+            expect(projected.pointCount, points);
+            checked = true;
+          }
+          feature.dispose();
+        }
+        layer.dispose();
+      }
+      expect(checked, isTrue);
+
+      tile.dispose();
+    });
+
+    test('Invalid geometry throws', () {
+      final tile = loadFixtureTile('044');
+      final layer = tile.getLayers().first;
+      final feature = layer.getFeatures().first;
+
+      expect(
+        () => feature.decodeProjected(const VtzProjection.tile()),
+        throwsA(isA<VtzGeometryException>()),
+      );
+
+      feature.dispose();
+      layer.dispose();
+      tile.dispose();
+    });
+  });
+}
@@ -0,0 +1,66 @@
+import 'dart:io';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:vtzero_dart/vtzero_dart.dart';
+
+void main() {
+  group('VtzStats', () {
+    final bytes = File('test/data/chart.pbf').readAsBytesSync();
+
+    test('Snapshot covers every function and latency path', () {
+      final stats = VtzStats.snapshot();
+
+      expect(stats.calls.keys, containsAll(VtzStatsFunction.values));
+      expect(stats.latency.keys, containsAll(VtzStatsLatency.values));
+    });
+
+    test('Counters track native calls when enabled', () {
+      VtzStats.reset();
+      final before = VtzStats.snapshot();
+
+      final tile = VtzTile.fromBytes(bytes);
+      final layers = tile.getLayers();
+      final features = layers.first.getFeatures();
+      for (final feature in features) {
+        feature.decodeGeometry();
+      }
+
+      final stats = VtzStats.snapshot();
+      if (!stats.enabled) {
+        // Built without VTZERO_DART_ENABLE_STATS: everything stays zero
+        expect(stats.calls[VtzStatsFunction.tileCreate], 0);
+        expect(stats.bytesProcessed, 0);
+      } else {
+        expect(stats.calls[VtzStatsFunction.tileCreate], 1);
+        expect(stats.calls[VtzStatsFunction.featureDecodeGeometry],
+            features.length);
+        expect(stats.bytesProcessed, bytes.length);
+        expect(stats.verticesEmitted, greaterThan(0));
+        expect(stats.latency[VtzStatsLatency.geometryDecode]!.count,
+            features.length);
+        expect(stats.liveTiles, before.liveTiles + 1);
+        expect(stats.liveFeatures, before.liveFeatures + features.length);
+      }
+
+      for (final feature in features) {
+        feature.dispose();
+      }
+      for (final layer in layers) {
+        layer.dispose();
+      }
+      tile.dispose();
+
+      if (stats.enabled) {
+        expect(VtzStats.snapshot().liveTiles, before.liveTiles);
+      }
+    });
+
+    test('Reset clears call counters', () {
+      VtzTile.fromBytes(bytes).dispose();
+      VtzStats.reset();
+
+      final stats = VtzStats.snapshot();
+      expect(stats.calls[VtzStatsFunction.tileCreate], 0);
+      expect(stats.latency[VtzStatsLatency.tileCreate]!.count, 0);
+    });
+  });
+}
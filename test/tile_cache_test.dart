@@ -0,0 +1,84 @@
+import 'dart:io';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:vtzero_dart/vtzero_dart.dart';
+
+void main() {
+  group('VtzTileCache', () {
+    final bytes = File('test/data/chart.pbf').readAsBytesSync();
+
+    test('Revisits are served from the cache', () {
+      final cache = VtzTileCache();
+
+      expect(cache.get(source: 1, z: 10, x: 5, y: 7), isNull);
+
+      final tile = cache.put(source: 1, z: 10, x: 5, y: 7, bytes: bytes);
+      final layerCount = tile.getLayers().length;
+      tile.dispose();
+
+      final cached = cache.get(source: 1, z: 10, x: 5, y: 7);
+      expect(cached, isNotNull);
+      // Each cached tile has its own layer iterator
+      expect(cached!.getLayers(), hasLength(layerCount));
+      cached.dispose();
+
+      final stats = cache.stats;
+      expect(stats.hits, 1);
+      expect(stats.misses, 1);
+      expect(stats.entries, 1);
+      expect(stats.pinned, 0);
+
+      cache.dispose();
+    });
+
+    test('Keys include the source', () {
+      final cache = VtzTileCache();
+
+      cache.put(source: 1, z: 0, x: 0, y: 0, bytes: bytes).dispose();
+      expect(cache.get(source: 2, z: 0, x: 0, y: 0), isNull);
+
+      cache.dispose();
+    });
+
+    test('Least recently used tiles are evicted over budget', () {
+      final cache =
+          VtzTileCache(byteBudget: bytes.length * 2 + 1024, shardCount: 1);
+
+      for (var x = 0; x < 4; x++) {
+        cache.put(source: 1, z: 4, x: x, y: 0, bytes: bytes).dispose();
+      }
+
+      final stats = cache.stats;
+      expect(stats.evictions, 2);
+      expect(stats.entries, 2);
+      expect(stats.bytes, lessThanOrEqualTo(stats.byteBudget));
+      expect(cache.get(source: 1, z: 4, x: 0, y: 0), isNull);
+      cache.get(source: 1, z: 4, x: 3, y: 0)!.dispose();
+
+      cache.dispose();
+    });
+
+    test('Pinned tiles are not evicted', () {
+      final cache = VtzTileCache(byteBudget: 1, shardCount: 1);
+
+      final tile = cache.put(source: 1, z: 0, x: 0, y: 0, bytes: bytes);
+      expect(cache.stats.pinned, 1);
+
+      cache.put(source: 1, z: 0, x: 1, y: 0, bytes: bytes).dispose();
+      final revisited = cache.get(source: 1, z: 0, x: 0, y: 0);
+      expect(revisited, isNotNull);
+
+      revisited!.dispose();
+      tile.dispose();
+      cache.dispose();
+    });
+
+    test('Tiles stay valid after the cache is disposed', () {
+      final cache = VtzTileCache();
+      final tile = cache.put(source: 1, z: 0, x: 0, y: 0, bytes: bytes);
+      cache.dispose();
+
+      expect(tile.getLayers(), isNotEmpty);
+      tile.dispose();
+    });
+  });
+}